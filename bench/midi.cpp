@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include "system.h"
+
+#ifdef WANT_FMMIDI
+#include <vector>
+#include "decoder_fmmidi.h"
+
+// Simulates a dense General MIDI song: all 16 channels play 4 note chords
+// (channel 10 is percussion) and are retriggered every 1/8 second.
+static int ChordNote(int ch, int n, int step) {
+	return 36 + ((ch * 7 + n * 4 + step * 5) % 48);
+}
+
+static void PlayDenseSong(FmMidiDecoder& dec, int step) {
+	for (int ch = 0; ch < 16; ++ch) {
+		for (int n = 0; n < 4; ++n) {
+			// Note off of the previous chord and note on of the next one
+			if (step > 0) {
+				dec.OnMidiMessage(0x80 | ch | (ChordNote(ch, n, step - 1) << 8) | (64 << 16));
+			}
+			dec.OnMidiMessage(0x90 | ch | (ChordNote(ch, n, step) << 8) | (100 << 16));
+		}
+	}
+}
+
+static void BM_FmMidiSynthesize(benchmark::State& state) {
+	FmMidiDecoder dec;
+	for (int ch = 0; ch < 16; ++ch) {
+		// Program change, vibrato and panning
+		dec.OnMidiMessage(0xC0 | ch | ((ch * 8) << 8));
+		dec.OnMidiMessage(0xB0 | ch | (1 << 8) | ((ch * 8) << 16));
+		dec.OnMidiMessage(0xB0 | ch | (10 << 8) | ((ch * 8) << 16));
+	}
+
+	// 1/8 second of 16 bit stereo audio
+	std::vector<uint8_t> buffer(EP_MIDI_FREQ / 8 * 2 * 2);
+	int step = 0;
+	for (auto _: state) {
+		PlayDenseSong(dec, step++);
+		dec.FillBuffer(buffer.data(), static_cast<int>(buffer.size()));
+	}
+	state.SetItemsProcessed(state.iterations() * EP_MIDI_FREQ / 8);
+}
+
+BENCHMARK(BM_FmMidiSynthesize);
+#endif
+
+BENCHMARK_MAIN();
@@ -5,6 +5,7 @@
 #include <text.h>
 #include <pixel_format.h>
 #include <cache.h>
+#include <utils.h>
 
 const std::string text = "Alex $A landed a critical hit on Slime $B!";
 char32_t symbol = '\\';
@@ -81,4 +82,63 @@ static void BM_TextDrawCharColorEx(benchmark::State& state) {
 
 BENCHMARK(BM_TextDrawCharColorEx);
 
+static const std::string ascii_text = "The party received 1200 experience points and 300 gold. Alex leveled up!";
+static const std::string mixed_text = u8"\u30A2\u30EC\u30C3\u30AF\u30B9\u306F 1200 \u306E\u7D4C\u9A13\u5024\u3068 300 \u30B4\u30FC\u30EB\u30C9\u3092\u624B\u306B\u5165\u308C\u305F! Alex leveled up!";
+
+static void BM_DecodeUTF32Ascii(benchmark::State& state) {
+	for (auto _: state) {
+		auto u32 = Utils::DecodeUTF32(ascii_text);
+		benchmark::DoNotOptimize(u32);
+	}
+	state.SetBytesProcessed(state.iterations() * ascii_text.size());
+}
+
+BENCHMARK(BM_DecodeUTF32Ascii);
+
+static void BM_DecodeUTF32Mixed(benchmark::State& state) {
+	for (auto _: state) {
+		auto u32 = Utils::DecodeUTF32(mixed_text);
+		benchmark::DoNotOptimize(u32);
+	}
+	state.SetBytesProcessed(state.iterations() * mixed_text.size());
+}
+
+BENCHMARK(BM_DecodeUTF32Mixed);
+
+static void BM_DecodeUTF16Ascii(benchmark::State& state) {
+	for (auto _: state) {
+		auto u16 = Utils::DecodeUTF16(ascii_text);
+		benchmark::DoNotOptimize(u16);
+	}
+	state.SetBytesProcessed(state.iterations() * ascii_text.size());
+}
+
+BENCHMARK(BM_DecodeUTF16Ascii);
+
+static void BM_EncodeUTF32Mixed(benchmark::State& state) {
+	auto u32 = Utils::DecodeUTF32(mixed_text);
+	for (auto _: state) {
+		auto u8 = Utils::EncodeUTF(u32);
+		benchmark::DoNotOptimize(u8);
+	}
+	state.SetBytesProcessed(state.iterations() * mixed_text.size());
+}
+
+BENCHMARK(BM_EncodeUTF32Mixed);
+
+static void BM_UTF8NextMixed(benchmark::State& state) {
+	for (auto _: state) {
+		const char* iter = mixed_text.data();
+		const char* end = iter + mixed_text.size();
+		while (iter != end) {
+			auto ret = Utils::UTF8Next(iter, end);
+			benchmark::DoNotOptimize(ret.ch);
+			iter = ret.next;
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * mixed_text.size());
+}
+
+BENCHMARK(BM_UTF8NextMixed);
+
 BENCHMARK_MAIN();
@@ -21,6 +21,7 @@
 #include "baseui.h"
 #include "player.h"
 #include "game_clock.h"
+#include "output.h"
 
 AudioInterface& Audio() {
 	static EmptyAudio default_;
@@ -53,3 +54,25 @@ bool EmptyAudio::BGM_PlayedOnce() const {
 	// 5 seconds, arbitrary
 	return BGM_GetTicks() > (Game_Clock::GetTargetGameFps() * 5);
 }
+
+double AudioStats::GetLoad() const {
+	if (audio_time <= 0) {
+		return 0.0;
+	}
+	return callback_time * 100.0 / audio_time;
+}
+
+std::string AudioStats::ToString() const {
+	return fmt::format("load {:.1f}% (max {} us), {} underruns, BGM {} us, SE {} us",
+			GetLoad(), callback_time_max, underruns, bgm.decode_time, se.decode_time);
+}
+
+std::string AudioStats::ToJson() const {
+	auto channel = [](const Channel& c) {
+		return fmt::format(R"({{"decode_time":{},"decode_time_max":{},"decode_calls":{}}})",
+				c.decode_time, c.decode_time_max, c.decode_calls);
+	};
+
+	return fmt::format(R"({{"callbacks":{},"callback_time":{},"callback_time_max":{},"audio_time":{},"underruns":{},"bgm":{},"se":{}}})",
+			callbacks, callback_time, callback_time_max, audio_time, underruns, channel(bgm), channel(se));
+}
@@ -19,8 +19,54 @@
 #define EP_AUDIO_H
 
 // Headers
+#include <cstdint>
 #include <string>
 
+/**
+ * Audio performance counters collected by the audio backend.
+ * All times are in microseconds.
+ *
+ * Only backends based on GenericAudio collect them. SDL_mixer and OpenAL
+ * mix outside of the Player and report zeroes.
+ */
+struct AudioStats {
+	struct Channel {
+		/** Time spent in the decoder (includes resampling) */
+		int64_t decode_time = 0;
+		/** Worst decode time of a single call */
+		int64_t decode_time_max = 0;
+		/** Number of decode calls */
+		int64_t decode_calls = 0;
+	};
+
+	/** Number of audio callbacks */
+	int64_t callbacks = 0;
+	/** Time spent in the audio callback */
+	int64_t callback_time = 0;
+	/** Worst time of a single audio callback */
+	int64_t callback_time_max = 0;
+	/** Duration of the audio produced by the callbacks */
+	int64_t audio_time = 0;
+	/**
+	 * Callbacks which took longer than the duration of audio they produced.
+	 * This is an estimate, the backend cannot see whether the device ran dry.
+	 */
+	int64_t underruns = 0;
+	/** Counters of all BGM channels */
+	Channel bgm;
+	/** Counters of all SE channels */
+	Channel se;
+
+	/** @return percentage of the audio duration spent in the callback */
+	double GetLoad() const;
+
+	/** @return human readable summary */
+	std::string ToString() const;
+
+	/** @return all counters as a single line JSON object, logged on shutdown */
+	std::string ToJson() const;
+};
+
 /**
  * Base Audio class.
  */
@@ -109,6 +155,14 @@ struct AudioInterface {
 	 * Stops the currently playing sound effect.
 	 */
 	virtual void SE_Stop() = 0;
+
+	/**
+	 * Returns the performance counters of the audio backend.
+	 * Backends which do not collect them (SDL_mixer, OpenAL) return zeroes.
+	 *
+	 * @return audio statistics
+	 */
+	virtual AudioStats GetStats() const { return {}; }
 };
 
 struct EmptyAudio : public AudioInterface {
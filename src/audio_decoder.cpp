@@ -119,9 +119,10 @@ std::unique_ptr<AudioDecoder> AudioDecoder::Create(Filesystem_Stream::InputStrea
 	}
 	stream.seekg(0, std::ios::beg);
 
-#if !(defined(HAVE_WILDMIDI) || defined(HAVE_XMP))
-	/* WildMidi and XMP are the only audio decoders that need the filename passed
-	 * directly, this avoids a warning about the possibly unused variable
+#if !(defined(HAVE_WILDMIDI) || defined(HAVE_XMP) || defined(WANT_FASTWAV))
+	/* WildMidi, XMP and WAV (for memory mapping) are the only audio decoders
+	 * that need the filename passed directly, this avoids a warning about the
+	 * possibly unused variable
 	 */
 	(void)filename;
 #endif
@@ -179,7 +180,7 @@ std::unique_ptr<AudioDecoder> AudioDecoder::Create(Filesystem_Stream::InputStrea
 		Utils::SwapByteOrder(raw_enc);
 		stream.seekg(0, std::ios::ios_base::beg);
 		if (raw_enc == 0x01) { // Codec is normal PCM
-			return add_resampler(std::make_unique<WavDecoder>());
+			return add_resampler(std::make_unique<WavDecoder>(filename));
 		}
 	}
 
@@ -326,6 +327,10 @@ int AudioDecoder::GetTicks() const {
 	return 0;
 }
 
+std::shared_ptr<const void> AudioDecoder::GetSampleData(const uint8_t*&, size_t&) const {
+	return nullptr;
+}
+
 int AudioDecoder::GetSamplesizeForFormat(AudioDecoder::Format format) {
 	switch (format) {
 		case Format::S8:
@@ -271,6 +271,17 @@ public:
 	 */
 	virtual int GetTicks() const;
 
+	/**
+	 * Provides direct access to the whole audio sample when it is already
+	 * in memory in the format reported by GetFormat (e.g. memory mapped PCM).
+	 * The data stays valid as long as the returned owner is alive.
+	 *
+	 * @param data Filled with a pointer to the sample data
+	 * @param size Filled with the size of the sample data in bytes
+	 * @return owner of the data or nullptr when not supported
+	 */
+	virtual std::shared_ptr<const void> GetSampleData(const uint8_t*& data, size_t& size) const;
+
 	/**
 	 * Returns the amount of bytes per sample.
 	 *
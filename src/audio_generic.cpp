@@ -17,10 +17,12 @@
 
 #include "system.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 #include "audio_generic.h"
 #include "filefinder.h"
+#include "game_clock.h"
 #include "output.h"
 
 GenericAudio::BgmChannel GenericAudio::BGM_Channels[nr_of_bgm_channels];
@@ -31,6 +33,22 @@ std::vector<int16_t> GenericAudio::sample_buffer = {};
 std::vector<uint8_t> GenericAudio::scrap_buffer = {};
 unsigned GenericAudio::scrap_buffer_size = 0;
 std::vector<float> GenericAudio::mixer_buffer = {};
+AudioStats GenericAudio::stats = {};
+
+namespace {
+	// Minimum time between two underrun warnings in the log
+	constexpr auto underrun_log_interval = std::chrono::seconds(5);
+
+	int64_t ElapsedUs(Game_Clock::time_point start, Game_Clock::time_point end) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	}
+
+	void AddDecodeTime(AudioStats::Channel& chan, int64_t us) {
+		chan.decode_time += us;
+		chan.decode_time_max = std::max(chan.decode_time_max, us);
+		++chan.decode_calls;
+	}
+}
 
 GenericAudio::GenericAudio() {
 	for (auto& BGM_Channel : BGM_Channels) {
@@ -40,6 +58,7 @@ GenericAudio::GenericAudio() {
 		SE_Channel.decoder.reset();
 	}
 	BGM_PlayedOnceIndicator = false;
+	stats = {};
 
 	// Initialize to some arbitrary (low-quality) format to prevent crashes
 	// when the inheriting class doesn't call SetFormat
@@ -47,6 +66,9 @@ GenericAudio::GenericAudio() {
 }
 
 GenericAudio::~GenericAudio() {
+	if (stats.callbacks > 0) {
+		Output::Debug("Audio stats: {}", stats.ToJson());
+	}
 }
 
 void GenericAudio::BGM_Play(const std::string& file, int volume, int pitch, int fadein) {
@@ -164,7 +186,29 @@ void GenericAudio::SE_Stop() {
 }
 
 void GenericAudio::Update() {
-	// no-op, handled by the Decode function called through a thread
+	// Decoding is handled by the Decode function called through a thread.
+	// Only report underruns here because logging in the audio thread is too slow.
+	auto now = Game_Clock::now();
+	if (now - last_underrun_log < underrun_log_interval) {
+		return;
+	}
+
+	LockMutex();
+	AudioStats current = stats;
+	UnlockMutex();
+
+	if (current.underruns > logged_underruns) {
+		Output::Debug("Audio: {} underruns ({})", current.underruns - logged_underruns, current.ToString());
+		logged_underruns = current.underruns;
+	}
+	last_underrun_log = now;
+}
+
+AudioStats GenericAudio::GetStats() const {
+	LockMutex();
+	AudioStats current = stats;
+	UnlockMutex();
+	return current;
 }
 
 void GenericAudio::SetFormat(int frequency, AudioDecoder::Format format, int channels) {
@@ -219,6 +263,7 @@ bool GenericAudio::PlayOnChannel(SeChannel& chan, const std::string& file, int v
 }
 
 void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
+	auto callback_start = Game_Clock::now();
 	bool channel_active = false;
 	float total_volume = 0;
 	int samples_per_frame = buffer_length / output_format.channels / 2;
@@ -268,7 +313,9 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 					unsigned bytes_to_read = (samplesize * channels * samples_per_frame);
 					bytes_to_read = (bytes_to_read < scrap_buffer_size) ? bytes_to_read : scrap_buffer_size;
 
+					auto decode_start = Game_Clock::now();
 					read_bytes = currently_mixed_channel.decoder->Decode(scrap_buffer.data(), bytes_to_read);
+					AddDecodeTime(is_bgm_channel ? stats.bgm : stats.se, ElapsedUs(decode_start, Game_Clock::now()));
 
 					if (read_bytes < 0) {
 						// An error occured when reading - the channel is faulty - discard
@@ -301,7 +348,9 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 					unsigned bytes_to_read = (samplesize * channels * samples_per_frame);
 					bytes_to_read = (bytes_to_read < scrap_buffer_size) ? bytes_to_read : scrap_buffer_size;
 
+					auto decode_start = Game_Clock::now();
 					read_bytes = currently_mixed_channel.decoder->Decode(scrap_buffer.data(), bytes_to_read);
+					AddDecodeTime(is_bgm_channel ? stats.bgm : stats.se, ElapsedUs(decode_start, Game_Clock::now()));
 
 					if (read_bytes < 0) {
 						// An error occured when reading - the channel is faulty - discard
@@ -409,4 +458,14 @@ void GenericAudio::Decode(uint8_t* output_buffer, int buffer_length) {
 	} else {
 		memset(output_buffer, '\0', buffer_length);
 	}
+
+	int64_t callback_time = ElapsedUs(callback_start, Game_Clock::now());
+	int64_t audio_time = static_cast<int64_t>(samples_per_frame) * 1000000 / output_format.frequency;
+	++stats.callbacks;
+	stats.callback_time += callback_time;
+	stats.callback_time_max = std::max(stats.callback_time_max, callback_time);
+	stats.audio_time += audio_time;
+	if (callback_time > audio_time) {
+		++stats.underruns;
+	}
 }
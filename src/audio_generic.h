@@ -21,6 +21,7 @@
 #include "audio.h"
 #include "audio_decoder.h"
 #include "audio_secache.h"
+#include "game_clock.h"
 
 /**
  * A software implementation for handling EasyRPG Audio utilizing the
@@ -54,6 +55,7 @@ public:
 	void SE_Play(std::string const& file, int volume, int pitch) override;
 	void SE_Stop() override;
 	virtual void Update() override;
+	AudioStats GetStats() const override;
 
 	void SetFormat(int frequency, AudioDecoder::Format format, int channels);
 
@@ -81,6 +83,9 @@ private:
 	};
 	Format output_format = {};
 
+	Game_Clock::time_point last_underrun_log = {};
+	int64_t logged_underruns = 0;
+
 	bool PlayOnChannel(BgmChannel& chan,std::string const& file, int volume, int pitch, int fadein);
 	bool PlayOnChannel(SeChannel& chan,std::string const& file, int volume, int pitch);
 
@@ -96,6 +101,8 @@ private:
 	static std::vector<uint8_t> scrap_buffer;
 	static unsigned scrap_buffer_size;
 	static std::vector<float> mixer_buffer;
+	/** Performance counters, updated by Decode */
+	static AudioStats stats;
 };
 
 #endif
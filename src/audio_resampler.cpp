@@ -215,19 +215,33 @@ AudioResampler::AudioResampler(std::unique_ptr<AudioDecoder> wrapped, AudioResam
 				sampling_quality = SRC_SINC_BEST_QUALITY;
 				break;
 		}
+	#elif defined(WANT_BUILTIN_RESAMPLER)
+		switch (quality) {
+			case Quality::Low:
+				sampling_quality = static_cast<int>(SincResampler::Quality::Low);
+				break;
+			case Quality::Medium:
+				sampling_quality = static_cast<int>(SincResampler::Quality::Medium);
+				break;
+			case Quality::High:
+				sampling_quality = static_cast<int>(SincResampler::Quality::High);
+				break;
+		}
 	#endif
 
 	finished = false;
 }
 
 AudioResampler::~AudioResampler() {
-	if (conversion_state) {
 	#if defined(HAVE_LIBSPEEXDSP)
+		if (conversion_state) {
 			speex_resampler_destroy(conversion_state);
+		}
 	#elif defined(HAVE_LIBSAMPLERATE)
+		if (conversion_state) {
 			src_delete(conversion_state);
+		}
 	#endif
-	}
 }
 
 bool AudioResampler::WasInited() const {
@@ -260,6 +274,11 @@ bool AudioResampler::Open(Filesystem_Stream::InputStream stream) {
 			speex_resampler_skip_zeros(conversion_state);
 		#elif defined(HAVE_LIBSAMPLERATE)
 			conversion_state = src_new(sampling_quality, nr_of_channels, &lasterror);
+		#elif defined(WANT_BUILTIN_RESAMPLER)
+			conversion_state = std::make_unique<SincResampler>(nr_of_channels, static_cast<SincResampler::Quality>(sampling_quality));
+			conversion_state->SetRate(input_rate, output_rate);
+			conversion_data.ratio_num = input_rate;
+			conversion_data.ratio_denom = output_rate;
 		#endif
 
 		//Init the conversion data structure
@@ -285,6 +304,8 @@ bool AudioResampler::Seek(std::streamoff offset, std::ios_base::seekdir origin)
 			speex_resampler_reset_mem(conversion_state);
 		#elif defined(HAVE_LIBSAMPLERATE)
 			src_reset(conversion_state);
+		#elif defined(WANT_BUILTIN_RESAMPLER)
+			conversion_state->Reset();
 		#endif
 		return true;
 	}
@@ -473,11 +494,16 @@ int AudioResampler::FillBufferDifferentRate(uint8_t* buffer, int length) {
 	uint8_t * advanced_input_buffer = internal_buffer;
 	int unused_frames = 0;
 	int empty_buffer_space = 0;
-	int error = 0;
-	
-	#ifdef HAVE_LIBSPEEXDSP
+	#if defined(HAVE_LIBSPEEXDSP) || defined(HAVE_LIBSAMPLERATE)
+		int error = 0;
+	#endif
+
+	#if defined(HAVE_LIBSPEEXDSP)
 		spx_uint32_t numerator = 0;
 		spx_uint32_t denominator = 0;
+	#elif defined(WANT_BUILTIN_RESAMPLER)
+		uint32_t numerator = 0;
+		uint32_t denominator = 0;
 	#endif
 
 	while (total_output_frames > 0) {
@@ -569,6 +595,24 @@ int AudioResampler::FillBufferDifferentRate(uint8_t* buffer, int length) {
 				error_message = src_strerror(error);
 				return ERROR;
 			}
+		#elif defined(WANT_BUILTIN_RESAMPLER)
+			conversion_data.input_frames_used = conversion_data.input_frames;
+			conversion_data.output_frames_gen = conversion_data.output_frames;
+
+			//The ratio is a fraction (input/output), changing it is cheap
+			numerator = input_rate * pitch;
+			denominator = output_rate * STANDARD_PITCH;
+			if (pitch_handled_by_decoder) {
+				numerator = input_rate;
+				denominator = output_rate;
+			}
+			if (conversion_data.ratio_num != numerator || conversion_data.ratio_denom != denominator) {
+				conversion_state->SetRate(numerator, denominator);
+				conversion_data.ratio_num = numerator;
+				conversion_data.ratio_denom = denominator;
+			}
+
+			conversion_state->Process((float*)internal_buffer, conversion_data.input_frames_used, (float*)buffer, conversion_data.output_frames_gen, wrapped_decoder->IsFinished());
 		#endif
 
 		total_output_frames -= conversion_data.output_frames_gen;
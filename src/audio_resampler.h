@@ -29,10 +29,12 @@
 #include <speex/speex_resampler.h>
 #elif defined(HAVE_LIBSAMPLERATE)
 #include <samplerate.h>
+#elif defined(WANT_BUILTIN_RESAMPLER)
+#include "audio_resampler_sinc.h"
 #endif
 
 /**
- * Audio resampler powered by Libspeexdsp or Libsamplerate
+ * Audio resampler powered by Libspeexdsp, Libsamplerate or the builtin SincResampler
  * Wraps another decoder and provides resampling.
  */
 class AudioResampler : public AudioDecoder {
@@ -121,6 +123,7 @@ public:
 	 * Supported formats are:
 	 *  * float,int16_t for libspeexdsp
 	 *  * float for libsamplerate
+	 *  * float for the builtin resampler
 	 * The channel setting is redirected to the wrapped decoder.
 	 * The frequency setting controls the resampler.
 	 *
@@ -192,6 +195,13 @@ private:
 	#elif defined(HAVE_LIBSAMPLERATE)
 		SRC_DATA conversion_data;
 		SRC_STATE * conversion_state = nullptr;
+	#elif defined(WANT_BUILTIN_RESAMPLER)
+		struct {
+			uint32_t input_frames, output_frames;
+			uint32_t input_frames_used, output_frames_gen;
+			uint32_t ratio_num, ratio_denom;
+		} conversion_data;
+		std::unique_ptr<SincResampler> conversion_state;
 	#endif
 
 	/**
@@ -0,0 +1,270 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "audio_resampler_sinc.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+	// Cutoff frequencies are rounded down to multiples of 1/CUTOFF_STEPS
+	// to share filter banks between similar rates
+	constexpr int CUTOFF_STEPS = 64;
+
+	// Input frames buffered in addition to the filter length
+	constexpr int HISTORY_CHUNK = 1024;
+
+	// Upper limit of the ratio, prevents skipping more frames than buffered
+	constexpr uint32_t MAX_RATIO = 256;
+
+	std::shared_ptr<const SincResampler::FilterBank> CreateFilterBank(int half_taps, int phases, int cutoff_key) {
+		auto bank = std::make_shared<SincResampler::FilterBank>();
+		const int taps = half_taps * 2;
+		const double cutoff = static_cast<double>(cutoff_key) / CUTOFF_STEPS;
+
+		bank->taps = taps;
+		bank->phases = phases;
+		bank->coeffs.resize((phases + 1) * taps);
+
+		for (int p = 0; p <= phases; ++p) {
+			float* row = &bank->coeffs[p * taps];
+			double sum = 0.0;
+			for (int k = 0; k < taps; ++k) {
+				// Distance of the tap to the (fractional) output position
+				double d = k - (half_taps - 1) - static_cast<double>(p) / phases;
+				double x = d * cutoff * M_PI;
+				double sinc = (x == 0.0) ? 1.0 : std::sin(x) / x;
+				// Blackman window
+				double w = 0.0;
+				if (std::abs(d) < half_taps) {
+					double t = M_PI * d / half_taps;
+					w = 0.42 + 0.5 * std::cos(t) + 0.08 * std::cos(2.0 * t);
+				}
+				double h = cutoff * sinc * w;
+				row[k] = static_cast<float>(h);
+				sum += h;
+			}
+			// Normalize for unity gain at DC
+			if (sum != 0.0) {
+				for (int k = 0; k < taps; ++k) {
+					row[k] = static_cast<float>(row[k] / sum);
+				}
+			}
+		}
+
+		return bank;
+	}
+
+	std::shared_ptr<const SincResampler::FilterBank> GetFilterBank(int half_taps, int phases, int cutoff_key) {
+		static std::mutex mutex;
+		static std::map<std::tuple<int, int, int>, std::weak_ptr<const SincResampler::FilterBank>> banks;
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto& entry = banks[std::make_tuple(half_taps, phases, cutoff_key)];
+		auto bank = entry.lock();
+		if (!bank) {
+			bank = CreateFilterBank(half_taps, phases, cutoff_key);
+			entry = bank;
+		}
+		return bank;
+	}
+
+	/**
+	 * Dot product with 4 independent accumulators.
+	 * Allows vectorization without relaxing the floating point model.
+	 * taps must be a multiple of 4.
+	 */
+	inline float DotProduct(const float* x, const float* h, int taps) {
+		float a0 = 0.0f, a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+		for (int k = 0; k < taps; k += 4) {
+			a0 += x[k] * h[k];
+			a1 += x[k + 1] * h[k + 1];
+			a2 += x[k + 2] * h[k + 2];
+			a3 += x[k + 3] * h[k + 3];
+		}
+		return (a0 + a1) + (a2 + a3);
+	}
+}
+
+SincResampler::SincResampler(int channels, Quality quality) :
+	channels(channels) {
+	assert(channels > 0);
+
+	switch (quality) {
+		case Quality::Low:
+			half_taps = 4;
+			phases = 32;
+			rolloff = 0.85f;
+			break;
+		case Quality::Medium:
+			half_taps = 8;
+			phases = 64;
+			rolloff = 0.9f;
+			break;
+		case Quality::High:
+			half_taps = 16;
+			phases = 128;
+			rolloff = 0.95f;
+			break;
+	}
+
+	history.resize(channels);
+	for (auto& h: history) {
+		h.resize(half_taps * 2 + HISTORY_CHUNK);
+	}
+
+	UpdateFilter();
+	Reset();
+}
+
+void SincResampler::SetRate(uint32_t num, uint32_t denom) {
+	if (num == 0 || denom == 0 || (num == ratio_num && denom == ratio_denom)) {
+		return;
+	}
+
+	ratio_num = num;
+	ratio_denom = denom;
+
+	step = (static_cast<uint64_t>(num) << 32) / denom;
+	step = std::max<uint64_t>(1, std::min<uint64_t>(step, static_cast<uint64_t>(MAX_RATIO) << 32));
+
+	UpdateFilter();
+}
+
+void SincResampler::UpdateFilter() {
+	// When downsampling the cutoff must be lowered to prevent aliasing
+	double cutoff = rolloff;
+	if (ratio_num > ratio_denom) {
+		cutoff = cutoff * ratio_denom / ratio_num;
+	}
+	int key = std::max(1, static_cast<int>(cutoff * CUTOFF_STEPS));
+
+	if (!bank || key != cutoff_key) {
+		cutoff_key = key;
+		bank = GetFilterBank(half_taps, phases, cutoff_key);
+	}
+}
+
+void SincResampler::Reset() {
+	// Start with half a filter of silence, the first output frame is
+	// then aligned with the first input frame
+	history_frames = half_taps - 1;
+	for (auto& h: history) {
+		std::fill(h.begin(), h.begin() + history_frames, 0.0f);
+	}
+	index = 0;
+	frac = 0;
+	tail_frames = 0;
+}
+
+void SincResampler::Process(const float* in, uint32_t& in_frames, float* out, uint32_t& out_frames, bool end_of_input) {
+	const int taps = bank->taps;
+	const int capacity = static_cast<int>(history[0].size());
+
+	uint32_t in_used = 0;
+	uint32_t out_gen = 0;
+
+	for (;;) {
+		// Produce as many frames as the history allows
+		while (out_gen < out_frames && index + taps <= history_frames) {
+			uint64_t phase_pos = static_cast<uint64_t>(frac) * phases;
+			int phase = static_cast<int>(phase_pos >> 32);
+			float t = static_cast<uint32_t>(phase_pos) * (1.0f / 4294967296.0f);
+			const float* h0 = &bank->coeffs[phase * taps];
+			const float* h1 = h0 + taps;
+
+			for (int c = 0; c < channels; ++c) {
+				const float* x = &history[c][index];
+				float a = DotProduct(x, h0, taps);
+				float b = DotProduct(x, h1, taps);
+				out[out_gen * channels + c] = a + (b - a) * t;
+			}
+
+			uint64_t pos = static_cast<uint64_t>(frac) + step;
+			index += static_cast<int>(pos >> 32);
+			frac = static_cast<uint32_t>(pos);
+			++out_gen;
+		}
+
+		if (out_gen == out_frames) {
+			break;
+		}
+
+		// Drop the frames which are not needed anymore
+		int drop = std::min(index, history_frames);
+		if (drop > 0) {
+			for (auto& h: history) {
+				std::copy(h.begin() + drop, h.begin() + history_frames, h.begin());
+			}
+			history_frames -= drop;
+			index -= drop;
+		}
+
+		// Frames which are skipped completely (large ratios) are not buffered
+		while (index > 0 && in_used < in_frames) {
+			--index;
+			++in_used;
+		}
+
+		// Append new input
+		int count = std::min<int>(in_frames - in_used, capacity - history_frames);
+		if (count > 0) {
+			const float* src = in + in_used * channels;
+			for (int c = 0; c < channels; ++c) {
+				float* dst = &history[c][history_frames];
+				for (int i = 0; i < count; ++i) {
+					dst[i] = src[i * channels + c];
+				}
+			}
+			history_frames += count;
+			in_used += count;
+			continue;
+		}
+
+		if (!end_of_input || in_used < in_frames) {
+			break;
+		}
+
+		// Append half a filter of silence, the last output frame is then
+		// aligned with the last input frame
+		while (index > 0 && tail_frames < half_taps) {
+			--index;
+			++tail_frames;
+		}
+		count = std::min(half_taps - tail_frames, capacity - history_frames);
+		if (count <= 0) {
+			break;
+		}
+		for (auto& h: history) {
+			std::fill(h.begin() + history_frames, h.begin() + history_frames + count, 0.0f);
+		}
+		history_frames += count;
+		tail_frames += count;
+	}
+
+	in_frames = in_used;
+	out_frames = out_gen;
+}
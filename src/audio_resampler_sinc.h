@@ -0,0 +1,110 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_AUDIO_RESAMPLER_SINC_H
+#define EP_AUDIO_RESAMPLER_SINC_H
+
+// Headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Polyphase windowed-sinc resampler for interleaved float samples.
+ * Used by the AudioResampler when neither speexdsp nor libsamplerate
+ * are available.
+ *
+ * The filter bank only depends on the quality and on the cutoff frequency
+ * and is shared between all instances. Changing the rate (e.g. for pitch
+ * changes) only updates the step size unless the cutoff changes.
+ */
+class SincResampler {
+public:
+	/** Resampling quality, matches AudioResampler::Quality */
+	enum class Quality {
+		High,
+		Medium,
+		Low
+	};
+
+	/**
+	 * Constructs a resampler
+	 *
+	 * @param channels Number of interleaved channels
+	 * @param quality Filter quality, higher quality implies more filter taps
+	 */
+	SincResampler(int channels, Quality quality);
+
+	/**
+	 * Sets the resampling ratio as a fraction (input rate / output rate).
+	 *
+	 * @param num numerator
+	 * @param denom denominator
+	 */
+	void SetRate(uint32_t num, uint32_t denom);
+
+	/**
+	 * Clears the filter history, e.g. after seeking.
+	 */
+	void Reset();
+
+	/**
+	 * Resamples interleaved float frames.
+	 *
+	 * @param in input frames
+	 * @param in_frames number of input frames, set to the amount of frames consumed
+	 * @param out output buffer
+	 * @param out_frames size of the output buffer in frames, set to the amount of frames written
+	 * @param end_of_input whether no input follows, the filter is then flushed with silence
+	 *        to output the frames at the end of the input
+	 */
+	void Process(const float* in, uint32_t& in_frames, float* out, uint32_t& out_frames, bool end_of_input = false);
+
+	/** Coefficients of all filter phases */
+	struct FilterBank {
+		int taps = 0;
+		int phases = 0;
+		/** (phases + 1) rows of taps, the last row is for interpolating the last phase */
+		std::vector<float> coeffs;
+	};
+
+private:
+	void UpdateFilter();
+
+	int channels;
+	int half_taps;
+	int phases;
+	float rolloff;
+
+	uint32_t ratio_num = 1;
+	uint32_t ratio_denom = 1;
+	/** Position increment per output frame (32.32 fixed point) */
+	uint64_t step = uint64_t(1) << 32;
+	int cutoff_key = 0;
+	std::shared_ptr<const FilterBank> bank;
+
+	/** Deinterleaved input history, one buffer per channel */
+	std::vector<std::vector<float>> history;
+	int history_frames = 0;
+	/** Integer and fractional position in the history */
+	int index = 0;
+	uint32_t frac = 0;
+	/** Frames of silence appended after the end of the input */
+	int tail_frames = 0;
+};
+
+#endif
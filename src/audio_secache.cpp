@@ -56,7 +56,7 @@ namespace {
 			Output::Debug("SE: Freeing memory of {}", it->first);
 #endif
 
-			cache_size -= it->second->buffer.size();
+			cache_size -= it->second->GetSize();
 
 			it = cache.erase(it);
 		}
@@ -157,11 +157,14 @@ std::unique_ptr<AudioDecoder> AudioSeCache::CreateSeDecoder() {
 	assert(audio_decoder);
 
 	audio_decoder->GetFormat(se->frequency, se->format, se->channels);
-	se->buffer = audio_decoder->DecodeAll();
+	se->external_owner = audio_decoder->GetSampleData(se->external_data, se->external_size);
+	if (!se->external_owner) {
+		se->buffer = audio_decoder->DecodeAll();
+	}
 
 	cache.insert(std::make_pair(filename, se));
 
-	cache_size += se->buffer.size();
+	cache_size += se->GetSize();
 
 #ifdef CACHE_DEBUG
 	Output::Debug("SE cache size (Add): {}", cache_size / 1024.0 / 1024.0);
@@ -195,7 +198,7 @@ AudioSeDecoder::AudioSeDecoder(AudioSeRef se) :
 }
 
 bool AudioSeDecoder::IsFinished() const {
-	return offset >= se->buffer.size();
+	return offset >= se->GetSize();
 }
 
 void AudioSeDecoder::GetFormat(int &frequency, AudioDecoder::Format &format, int &channels) const {
@@ -207,11 +210,11 @@ void AudioSeDecoder::GetFormat(int &frequency, AudioDecoder::Format &format, int
 int AudioSeDecoder::FillBuffer(uint8_t *buffer, int size) {
 	int real_size = size;
 
-	if (offset + size > se->buffer.size()) {
-		real_size = se->buffer.size() - offset;
+	if (offset + size > se->GetSize()) {
+		real_size = se->GetSize() - offset;
 	}
 
-	memcpy(buffer, se->buffer.data() + offset, real_size);
+	memcpy(buffer, se->GetData() + offset, real_size);
 	offset += real_size;
 
 	return real_size;
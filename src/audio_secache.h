@@ -32,10 +32,22 @@ class AudioSeCache;
 
 /**
  * AudioSeData contains the decoded sample of AudioSeCache.
+ * The sample is either stored in buffer or, when the decoder provides
+ * direct access to the samples (e.g. memory mapped WAV), in external memory
+ * kept alive by external_owner.
  */
 class AudioSeData {
 public:
+	/** @return pointer to the sample data */
+	const uint8_t* GetData() const;
+
+	/** @return size of the sample data in bytes */
+	size_t GetSize() const;
+
 	std::vector<uint8_t> buffer;
+	std::shared_ptr<const void> external_owner;
+	const uint8_t* external_data = nullptr;
+	size_t external_size = 0;
 	Game_Clock::time_point last_access;
 	int frequency;
 	AudioDecoder::Format format;
@@ -44,6 +56,14 @@ public:
 
 typedef std::shared_ptr<AudioSeData> AudioSeRef;
 
+inline const uint8_t* AudioSeData::GetData() const {
+	return external_owner ? external_data : buffer.data();
+}
+
+inline size_t AudioSeData::GetSize() const {
+	return external_owner ? external_size : buffer.size();
+}
+
 /**
  * AudioSeDecoder operates on supplied AudioSeData and does format
  * conversions through the resamplers.
@@ -71,6 +91,8 @@ private:
  * once, otherwise returned from the cache.
  * The cache is flushed from recently (>10 seconds by default) unused
  * samples when it reaches the memory limit (5 MB by default).
+ * Memory mapped samples count towards the limit with their mapped size,
+ * so unused mappings are released like decoded samples.
  * Uses an internal AudioDecoder for handling the decoding.
  */
 class AudioSeCache {
@@ -95,7 +95,7 @@ Bitmap::Bitmap(const std::string& filename, bool transparent, uint32_t flags) {
 	format = (transparent ? pixel_format : opaque_pixel_format);
 	pixman_format = find_format(format);
 
-	auto stream = FileFinder::OpenInputStream(filename);
+	auto stream = FileFinder::OpenMappedInputStream(filename);
 	if (!stream) {
 		Output::Error("Couldn't open image file {}", filename);
 		return;
@@ -311,7 +311,7 @@ void Bitmap::HueChangeBlit(int x, int y, Bitmap const& src, Rect const& src_rect
 
 void Bitmap::TextDraw(Rect const& rect, int color, StringView text, Text::Alignment align) {
 	FontRef font = Font::Default();
-	Rect text_rect = font->GetSize(text);
+	Rect text_rect = Text::GetSize(*font, text);
 	int dx = text_rect.width - rect.width;
 
 	switch (align) {
@@ -336,7 +336,7 @@ void Bitmap::TextDraw(int x, int y, int color, StringView text, Text::Alignment
 
 void Bitmap::TextDraw(Rect const& rect, Color color, StringView text, Text::Alignment align) {
 	FontRef font = Font::Default();
-	Rect text_rect = font->GetSize(text);
+	Rect text_rect = Text::GetSize(*font, text);
 	int dx = text_rect.width - rect.width;
 
 	switch (align) {
@@ -476,6 +476,9 @@ static void initialize_palette() {
 }
 
 void Bitmap::Init(int width, int height, void* data, int pitch, bool destroy) {
+	static uint32_t next_id = 0;
+	id = ++next_id;
+
 	if (!pitch)
 		pitch = width * format.bytes;
 
@@ -534,6 +534,14 @@ public:
 	ImageOpacity ComputeImageOpacity() const;
 	ImageOpacity ComputeImageOpacity(Rect rect) const;
 
+	/**
+	 * Returns an id which is unique for every bitmap created at runtime.
+	 * Caches use it as a key because addresses are reused after freeing.
+	 *
+	 * @return bitmap id
+	 */
+	uint32_t GetId() const;
+
 protected:
 	DynamicFormat format;
 
@@ -568,8 +576,13 @@ protected:
 
 	pixman_op_t GetOperator(pixman_image_t* mask = nullptr) const;
 	bool read_only = false;
+	uint32_t id = 0;
 };
 
+inline uint32_t Bitmap::GetId() const {
+	return id;
+}
+
 inline ImageOpacity Bitmap::GetImageOpacity() const {
 	return image_opacity;
 }
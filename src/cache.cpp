@@ -33,6 +33,7 @@
 #include "bitmap.h"
 #include "output.h"
 #include "player.h"
+#include "text.h"
 #include <lcf/data.h>
 #include "game_clock.h"
 
@@ -527,6 +528,8 @@ void Cache::Clear() {
 	cache_tiles.clear();
 
 	system2_name.clear();
+
+	Text::ClearCache();
 }
 
 void Cache::SetSystemName(std::string filename) {
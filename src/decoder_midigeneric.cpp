@@ -23,8 +23,6 @@
 #include "decoder_midigeneric.h"
 #include "output.h"
 
-constexpr int GenericMidiDecoder::midi_default_tempo;
-
 // 1 ms of MIDI message resolution for a 44100 Hz samplerate
 constexpr int samples_per_play = 512;
 constexpr int bytes_per_sample = sizeof(int16_t) * 2;
@@ -66,14 +64,10 @@ bool GenericMidiDecoder::Open(Filesystem_Stream::InputStream stream) {
 		return false;
 	}
 
-	tempo.emplace_back(this, midi_default_tempo);
-
 	return true;
 }
 
 bool GenericMidiDecoder::Seek(std::streamoff offset, std::ios_base::seekdir origin) {
-	assert(!tempo.empty());
-
 	if (offset == 0 && origin == std::ios_base::beg) {
 		mtime = seq->rewind_to_loop();
 
@@ -81,24 +75,12 @@ bool GenericMidiDecoder::Seek(std::streamoff offset, std::ios_base::seekdir orig
 		// RPG_RT behaviour.
 		loops_to_end = mtime >= seq->get_total_time();
 
-		if (mtime > 0.0f) {
-			// Throw away all tempo data after the loop point
-			auto rit = std::find_if(tempo.rbegin(), tempo.rend(), [&](auto& t) { return t.mtime <= mtime; });
-			auto it = rit.base();
-			if (it != tempo.end()) {
-				tempo.erase(it, tempo.end());
-			}
-
-			// Bit of a hack, prevent stuck notes
-			// TODO: verify with a MIDI event stream inspector whether RPG_RT does this?
-			// FIXME synth->all_note_off();
-		} else {
-			tempo.clear();
-			tempo.emplace_back(this, midi_default_tempo);
-		}
+		// Bit of a hack, prevent stuck notes
+		// TODO: verify with a MIDI event stream inspector whether RPG_RT does this?
+		// FIXME synth->all_note_off();
 
 		if (mididec->GetName() == "WildMidi") {
-			mididec->Seek(tempo.back().GetSamples(mtime), origin);
+			mididec->Seek(static_cast<int>(mtime * frequency), origin);
 		} else {
 			mididec->Seek(GetTicks(), origin);
 		}
@@ -142,9 +124,8 @@ bool GenericMidiDecoder::SetPitch(int pitch) {
 }
 
 int GenericMidiDecoder::GetTicks() const {
-	assert(!tempo.empty());
-
-	return tempo.back().GetTicks(mtime);
+	// Binary search in the tempo map of the sequencer
+	return seq->get_ticks(mtime);
 }
 
 int GenericMidiDecoder::FillBuffer(uint8_t* buffer, int length) {
@@ -190,44 +171,9 @@ void GenericMidiDecoder::sysex_message(int, const void *data, std::size_t size)
 }
 
 void GenericMidiDecoder::meta_event(int event, const void * data, std::size_t size) {
-	assert(!tempo.empty());
-
 	mididec->OnMetaEvent(event, data, size);
-
-	const auto* d = reinterpret_cast<const uint8_t*>(data);
-
-	if (size == 3 && event == 0x51) {
-		uint32_t new_tempo = (static_cast<uint32_t>(static_cast<unsigned char>(d[0])) << 16)
-				| (static_cast<unsigned char>(d[1]) << 8)
-				| static_cast<unsigned char>(d[2]);
-		tempo.emplace_back(this, new_tempo, &tempo.back());
-	}
 }
 
 void GenericMidiDecoder::reset() {
 	mididec->OnMidiReset();
 }
-
-GenericMidiDecoder::MidiTempoData::MidiTempoData(const GenericMidiDecoder* midi, uint32_t cur_tempo, const MidiTempoData* prev)
-		: tempo(cur_tempo) {
-	ticks_per_sec = (float)midi->seq->get_division() / tempo * 1000000;
-	samples_per_tick = midi->frequency * 1 / ticks_per_sec;
-	mtime = midi->mtime;
-	if (prev) {
-		float delta = mtime - prev->mtime;
-		int ticks_since_last = static_cast<int>(ticks_per_sec * delta);
-		ticks = prev->ticks + ticks_since_last;
-		samples = prev->samples + ticks_since_last * samples_per_tick;
-	}
-}
-
-int GenericMidiDecoder::MidiTempoData::GetTicks(float mtime_cur) const {
-	float delta = mtime_cur - mtime;
-	return ticks + static_cast<int>(ticks_per_sec * delta);
-}
-
-int GenericMidiDecoder::MidiTempoData::GetSamples(float mtime_cur) const {
-	float delta = mtime_cur - mtime;
-	int ticks_since_last = static_cast<int>(ticks_per_sec * delta);
-	return samples + static_cast<int>(ticks_since_last * samples_per_tick);
-}
@@ -109,8 +109,6 @@ public:
 	std::vector<uint8_t> file_buffer;
 	size_t file_buffer_pos = 0;
 private:
-	static constexpr int midi_default_tempo = 500000;
-
 	std::unique_ptr<MidiDecoder> mididec;
 
 	int FillBuffer(uint8_t* buffer, int length) override;
@@ -120,24 +118,6 @@ private:
 	int frequency = 44100;
 	bool loops_to_end = false;
 
-	struct MidiTempoData {
-		MidiTempoData(const GenericMidiDecoder* midi, uint32_t cur_tempo, const MidiTempoData* prev = nullptr);
-
-		uint32_t tempo = midi_default_tempo;
-		float ticks_per_sec = 0.0f;
-		float mtime = 0.0f;
-		int ticks = 0;
-		int samples_per_tick = 0;
-		int samples = 0;
-
-		int GetTicks(float cur_mtime) const;
-		int GetSamples(float cur_mtime) const;
-	};
-
-	// Contains one entry per tempo change (latest on top)
-	// When looping all entries after the loop point are dropped
-	std::vector<MidiTempoData> tempo;
-
 	// midisequencer::output interface
 	void midi_message(int, uint_least32_t message) override;
 	void sysex_message(int, const void* data, std::size_t size) override;
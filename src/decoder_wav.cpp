@@ -20,11 +20,13 @@
 #ifdef WANT_FASTWAV
 
 // Headers
+#include <algorithm>
 #include <cstring>
 #include "decoder_wav.h"
 #include "utils.h"
 
-WavDecoder::WavDecoder()
+WavDecoder::WavDecoder(std::string filename) :
+	filename(std::move(filename))
 {
 	music_type = "wav";
 }
@@ -91,12 +93,30 @@ bool WavDecoder::Open(Filesystem_Stream::InputStream stream) {
 	audiobuf_offset = this->stream.tellg();
 	cur_pos = audiobuf_offset;
 	finished = false;
-	return this->stream.good();
+
+	// Uncompressed PCM can be read directly from a memory mapping
+	if (!filename.empty()) {
+		mapping = MappedFile::Open(filename);
+		if (mapping && mapping->size() >= audiobuf_offset) {
+			// Truncated files end early, like when reading the stream
+			chunk_size = static_cast<uint32_t>(std::min<size_t>(chunk_size, mapping->size() - audiobuf_offset));
+			// The stream is not needed anymore, release the file handle
+			this->stream = Filesystem_Stream::InputStream();
+		} else {
+			mapping.reset();
+		}
+	}
+
+	return true;
+}
+
+bool WavDecoder::IsOpen() const {
+	return mapping || stream;
 }
 
 bool WavDecoder::Seek(std::streamoff offset, std::ios_base::seekdir origin) {
 	finished = false;
-	if (!stream)
+	if (!IsOpen())
 		return false;
 	if (origin == std::ios_base::beg) {
 		offset += audiobuf_offset;
@@ -104,6 +124,20 @@ bool WavDecoder::Seek(std::streamoff offset, std::ios_base::seekdir origin) {
 	// FIXME: Proper sample count for seek
 	decoded_samples = 0;
 
+	if (mapping) {
+		std::streamoff pos = offset;
+		if (origin == std::ios_base::cur) {
+			pos += cur_pos;
+		} else if (origin == std::ios_base::end) {
+			pos += mapping->size();
+		}
+		if (pos < audiobuf_offset || pos > audiobuf_offset + chunk_size) {
+			return false;
+		}
+		cur_pos = static_cast<uint32_t>(pos);
+		return true;
+	}
+
 	bool success = stream.seekg(offset, origin).good();
 
 	if (!success) { stream.clear(); }
@@ -116,7 +150,7 @@ bool WavDecoder::IsFinished() const {
 }
 
 void WavDecoder::GetFormat(int& frequency, AudioDecoder::Format& format, int& channels) const {
-	if (!stream) return;
+	if (!IsOpen()) return;
 	frequency = samplerate;
 	channels = nchannels;
 	format = output_format;
@@ -127,10 +161,11 @@ bool WavDecoder::SetFormat(int, AudioDecoder::Format, int) {
 }
 
 int WavDecoder::FillBuffer(uint8_t* buffer, int length) {
-	if (!stream)
+	if (!IsOpen())
 		return -1;
 
 	int real_length;
+	uint32_t read_pos = cur_pos;
 
 	// Handle case that another chunk is behind "data" or file ended
 	if (cur_pos + length >= audiobuf_offset + chunk_size) {
@@ -146,7 +181,13 @@ int WavDecoder::FillBuffer(uint8_t* buffer, int length) {
 		return 0;
 	}
 
-	int decoded = stream.read(reinterpret_cast<char*>(buffer), real_length).gcount();
+	int decoded;
+	if (mapping) {
+		memcpy(buffer, mapping->data() + read_pos, real_length);
+		decoded = real_length;
+	} else {
+		decoded = stream.read(reinterpret_cast<char*>(buffer), real_length).gcount();
+	}
 
 	if (output_format == AudioDecoder::Format::S16) {
 		if (Utils::IsBigEndian()) {
@@ -176,4 +217,15 @@ int WavDecoder::GetTicks() const {
 	return decoded_samples / (samplerate * nchannels);
 }
 
+std::shared_ptr<const void> WavDecoder::GetSampleData(const uint8_t*& data, size_t& size) const {
+	// Multi-byte samples need a byte swap on big endian systems
+	if (!mapping || (Utils::IsBigEndian() && output_format != Format::U8)) {
+		return nullptr;
+	}
+
+	data = mapping->data() + audiobuf_offset;
+	size = chunk_size;
+	return mapping;
+}
+
 #endif
@@ -20,15 +20,22 @@
 
 // Headers
 #include "audio_decoder.h"
+#include "mapped_file.h"
 #include <string>
 #include <memory>
 
 /**
  * Standalone basic audio decoder for WAV
+ * When the file can be memory mapped the PCM data is read directly from
+ * the mapping instead of through the stream.
  */
 class WavDecoder : public AudioDecoder {
 public:
-	WavDecoder();
+	/**
+	 * @param filename Path to the file, used for memory mapping. When empty
+	 *                 the data is always read through the stream.
+	 */
+	explicit WavDecoder(std::string filename = {});
 
 	~WavDecoder();
 
@@ -44,10 +51,15 @@ public:
 
 	int GetTicks() const override;
 
+	std::shared_ptr<const void> GetSampleData(const uint8_t*& data, size_t& size) const override;
+
 private:
 	int FillBuffer(uint8_t* buffer, int length) override;
+	bool IsOpen() const;
 	Format output_format;
+	std::string filename;
 	Filesystem_Stream::InputStream stream;
+	std::shared_ptr<MappedFile> mapping;
 	bool finished;
 	uint32_t samplerate;
 	uint16_t nchannels;
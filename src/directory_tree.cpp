@@ -18,11 +18,17 @@
 #include "directory_tree.h"
 #include "filefinder.h"
 #include "filefinder_rtp.h"
+#include "filesystem_archive.h"
 #include "main_data.h"
 #include "output.h"
 #include "platform.h"
 #include "player.h"
+#include "utils.h"
 #include <lcf/reader_util.h>
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
 
 #ifdef EP_DEBUG_DIRECTORYTREE
 template <typename... Args>
@@ -38,6 +44,8 @@ namespace {
 	std::string make_key(StringView n) {
 		return lcf::ReaderUtil::Normalize(n);
 	};
+
+	constexpr StringView index_header = "EasyRPG DirectoryTree Index 1";
 }
 
 std::unique_ptr<DirectoryTree> DirectoryTree::Create() {
@@ -47,11 +55,23 @@ std::unique_ptr<DirectoryTree> DirectoryTree::Create() {
 std::unique_ptr<DirectoryTree> DirectoryTree::Create(std::string path) {
 	// FIXME: Requires VFS handle passed in, currently hardcoded to FileFinder
 
-	if (!(FileFinder::Exists(path) && FileFinder::IsDirectory(path, true))) {
+	if (!FileFinder::Exists(path)) {
 		return std::unique_ptr<DirectoryTree>();
 	}
+
+	std::shared_ptr<ArchiveFilesystem> archive;
+	if (!FileFinder::IsDirectory(path, true)) {
+		// Packed games are a single archive file
+		archive = ArchiveFilesystem::Open(path);
+		if (!archive) {
+			return std::unique_ptr<DirectoryTree>();
+		}
+		ArchiveFilesystem::Mount(path, archive);
+	}
+
 	std::unique_ptr<DirectoryTree> tree = std::make_unique<DirectoryTree>();
 	tree->root = std::move(path);
+	tree->archive = std::move(archive);
 
 	DebugLog("Create: {}", tree->root);
 
@@ -104,43 +124,57 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 		}
 	}
 
-	Platform::Directory dir(full_path);
-	if (!dir) {
-		Output::Debug("Error opening dir {}: {}", full_path, ::strerror(errno));
-		return nullptr;
-	}
-
-	while (dir.Read()) {
-		const auto& name = dir.GetEntryName();
-		Platform::FileType type = dir.GetEntryType();
+	// Archives are not written to index files, they have their own index
+	int64_t mtime = -1;
 
-		if (name == "." || name == "..") {
-			continue;
+	if (archive) {
+		if (!archive->ListDirectory(fs_path, entries)) {
+			DebugLog("Archive has no dir {}", full_path);
+			return nullptr;
 		}
+	} else {
+		// Taken before reading, changes while reading invalidate the index entry
+		mtime = Platform::File(full_path).GetModificationTime();
 
-		bool is_directory = false;
-		if (type == Platform::FileType::Directory) {
-			is_directory = true;
-		} else if (type == Platform::FileType::Unknown) {
-			is_directory = FileFinder::IsDirectory(FileFinder::MakePath(full_path, name), true);
+		Platform::Directory dir(full_path);
+		if (!dir) {
+			Output::Debug("Error opening dir {}: {}", full_path, ::strerror(errno));
+			return nullptr;
 		}
 
-		if (is_directory) {
-			std::string new_entry_key = make_key(name);
-			if (std::find_if(entries.begin(), entries.end(), [&](const auto& e) {
-				return e.type == DirectoryTree::FileType::Directory && make_key(e.name) == new_entry_key;
-			}) != entries.end()) {
-				Output::Warning("This game provides the folder \"{}\" twice.", name);
-				Output::Warning("This can lead to file not found errors. Merge the directories manually in a file browser.");
+		while (dir.Read()) {
+			const auto& name = dir.GetEntryName();
+			Platform::FileType type = dir.GetEntryType();
+
+			if (name == "." || name == "..") {
+				continue;
+			}
+
+			bool is_directory = false;
+			if (type == Platform::FileType::Directory) {
+				is_directory = true;
+			} else if (type == Platform::FileType::Unknown) {
+				is_directory = FileFinder::IsDirectory(FileFinder::MakePath(full_path, name), true);
+			}
+
+			if (is_directory) {
+				std::string new_entry_key = make_key(name);
+				if (std::find_if(entries.begin(), entries.end(), [&](const auto& e) {
+					return e.type == DirectoryTree::FileType::Directory && make_key(e.name) == new_entry_key;
+				}) != entries.end()) {
+					Output::Warning("This game provides the folder \"{}\" twice.", name);
+					Output::Warning("This can lead to file not found errors. Merge the directories manually in a file browser.");
+				}
 			}
-		}
 
-		entries.emplace_back(
-			name,
-			is_directory ? FileType::Directory : FileType::Regular);
+			entries.emplace_back(
+				name,
+				is_directory ? FileType::Directory : FileType::Regular);
+		}
 	}
 
 	dir_cache[dir_key] = fs_path;
+	mtime_cache[dir_key] = mtime;
 
 	DirectoryListType fs_cache_entry;
 
@@ -152,6 +186,101 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 	return &fs_cache.find(dir_key)->second;
 }
 
+int DirectoryTree::ReadIndex(std::istream& is) {
+	// Format:
+	// Header line, root path line
+	// Per directory: "D <mtime> <entry count> <real path>" followed by
+	// one line "<d|f> <name>" per entry
+	std::string line;
+	if (!Utils::ReadLine(is, line) || line != index_header) {
+		return 0;
+	}
+	if (!Utils::ReadLine(is, line) || line != root) {
+		DebugLog("ReadIndex: Index is for {}", line);
+		return 0;
+	}
+
+	int loaded = 0;
+	while (Utils::ReadLine(is, line)) {
+		if (line.size() < 2 || line[0] != 'D') {
+			break;
+		}
+
+		auto count_pos = line.find(' ', 2);
+		auto path_pos = (count_pos == std::string::npos) ? count_pos : line.find(' ', count_pos + 1);
+		if (path_pos == std::string::npos) {
+			break;
+		}
+		int64_t mtime = std::strtoll(line.c_str() + 2, nullptr, 10);
+		int count = std::atoi(line.c_str() + count_pos + 1);
+		if (count < 0) {
+			break;
+		}
+		std::string fs_path = line.substr(path_pos + 1);
+
+		DirectoryListType entries;
+		bool valid = true;
+		for (int i = 0; i < count; ++i) {
+			if (!Utils::ReadLine(is, line) || line.size() < 3 || (line[0] != 'd' && line[0] != 'f')) {
+				valid = false;
+				break;
+			}
+			std::string name = line.substr(2);
+			auto key = make_key(name);
+			entries.emplace(std::move(key), Entry(std::move(name), line[0] == 'd' ? FileType::Directory : FileType::Regular));
+		}
+		if (!valid) {
+			break;
+		}
+
+		auto dir_key = make_key(fs_path);
+		if (dir_cache.find(dir_key) != dir_cache.end()) {
+			continue;
+		}
+
+		if (mtime == -1 || Platform::File(MakePath(fs_path)).GetModificationTime() != mtime) {
+			DebugLog("ReadIndex: {} changed", fs_path);
+			continue;
+		}
+
+		dir_cache[dir_key] = fs_path;
+		mtime_cache[dir_key] = mtime;
+		fs_cache.emplace(dir_key, std::move(entries));
+		++loaded;
+	}
+
+	DebugLog("ReadIndex: {} directories", loaded);
+
+	return loaded;
+}
+
+bool DirectoryTree::WriteIndex(std::ostream& os) const {
+	os << index_header << "\n" << root << "\n";
+
+	for (const auto& dir: dir_cache) {
+		auto mtime_it = mtime_cache.find(dir.first);
+		auto fs_it = fs_cache.find(dir.first);
+		if (mtime_it == mtime_cache.end() || mtime_it->second == -1 || fs_it == fs_cache.end()) {
+			continue;
+		}
+
+		// Names with line breaks cannot be represented, rescan these directories
+		auto has_newline = [](StringView s) { return s.find_first_of("\r\n") != StringView::npos; };
+		if (has_newline(dir.second) || std::any_of(fs_it->second.begin(), fs_it->second.end(), [&](const auto& e) {
+				return has_newline(e.second.name);
+			})) {
+			continue;
+		}
+
+		os << "D " << mtime_it->second << " " << fs_it->second.size() << " " << dir.second << "\n";
+		for (const auto& entry: fs_it->second) {
+			os << (entry.second.type == FileType::Directory ? 'd' : 'f') << " " << entry.second.name << "\n";
+		}
+	}
+
+	return static_cast<bool>(os);
+}
+
 DirectoryTreeView DirectoryTree::Subtree(std::string sub_path) {
 	return DirectoryTreeView(this, std::move(sub_path));
 }
@@ -18,6 +18,7 @@
 #ifndef EP_DIRECTORY_TREE_H
 #define EP_DIRECTORY_TREE_H
 
+#include <iosfwd>
 #include <string>
 #include <vector>
 #include <memory>
@@ -26,6 +27,7 @@
 #include "span.h"
 #include "string_view.h"
 
+class ArchiveFilesystem;
 class DirectoryTreeView;
 
 /**
@@ -92,7 +94,7 @@ public:
 	/**
 	 * Creates a new DirectoryTree
 	 *
-	 * @param path root path of the tree
+	 * @param path root path of the tree, a directory or a game archive
 	 * @return new DirectoryTree
 	 */
 	static std::unique_ptr<DirectoryTree> Create(std::string path);
@@ -152,6 +154,25 @@ public:
 	 */
 	DirectoryListType* ListDirectory(StringView path = "") const;
 
+	/**
+	 * Fills the directory cache from an index written by WriteIndex.
+	 * Directories whose modification time changed since the index was
+	 * written are skipped and scanned again when accessed.
+	 * Indices of a different root path are ignored.
+	 *
+	 * @param is stream to read the index from
+	 * @return number of directories taken from the index
+	 */
+	int ReadIndex(std::istream& is);
+
+	/**
+	 * Writes all directories scanned so far to an index.
+	 *
+	 * @param os stream to write the index to
+	 * @return true on success
+	 */
+	bool WriteIndex(std::ostream& os) const;
+
 	/** Implicit conversion to TreeView */
 	operator DirectoryTreeView ();
 
@@ -163,6 +184,12 @@ private:
 
 	/** lowered dir -> real dir (both full path from root) */
 	mutable std::unordered_map<std::string, std::string> dir_cache;
+
+	/** lowered dir -> modification time when the directory was scanned */
+	mutable std::unordered_map<std::string, int64_t> mtime_cache;
+
+	/** Archive the tree is read from when the root is a packed game */
+	std::shared_ptr<ArchiveFilesystem> archive;
 };
 
 /**
@@ -0,0 +1,235 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "file_hash.h"
+#include "filefinder.h"
+#include "platform.h"
+#include "system.h"
+#include "utils.h"
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include <unordered_map>
+#include <zlib.h>
+
+#ifdef SUPPORT_THREADS
+#  include <condition_variable>
+#  include <deque>
+#  include <thread>
+#endif
+
+namespace {
+	struct CacheEntry {
+		int64_t mtime;
+		int64_t size;
+		uint32_t crc;
+	};
+
+	std::mutex mutex;
+	std::unordered_map<std::string, CacheEntry> entries;
+
+	bool FindLocked(const std::string& path, int64_t mtime, int64_t size, uint32_t& crc) {
+		auto it = entries.find(path);
+		if (it == entries.end() || it->second.mtime != mtime || it->second.size != size) {
+			return false;
+		}
+		crc = it->second.crc;
+		return true;
+	}
+
+	void AddLocked(const std::string& path, int64_t mtime, int64_t size, uint32_t crc) {
+		// Without a modification time changes of the file cannot be detected
+		if (mtime == -1) {
+			return;
+		}
+		entries[path] = { mtime, size, crc };
+	}
+
+#ifdef SUPPORT_THREADS
+	struct HashJob {
+		std::string path;
+		Filesystem_Stream::InputStream is;
+		int64_t mtime;
+		int64_t size;
+	};
+
+	std::condition_variable cv;
+	std::deque<HashJob> jobs;
+	/** File currently hashed by the worker, empty when idle */
+	std::string running_path;
+	bool quit = false;
+
+	void WorkerMain() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			cv.wait(lock, [] { return quit || !jobs.empty(); });
+			if (quit) {
+				return;
+			}
+
+			HashJob job = std::move(jobs.front());
+			jobs.pop_front();
+			running_path = job.path;
+			lock.unlock();
+
+			uint32_t crc = FileHash::CRC32(job.is);
+
+			lock.lock();
+			running_path.clear();
+			AddLocked(job.path, job.mtime, job.size, crc);
+			cv.notify_all();
+		}
+	}
+
+	bool IsQueuedLocked(const std::string& path) {
+		return running_path == path || std::any_of(jobs.begin(), jobs.end(), [&](const auto& job) { return job.path == path; });
+	}
+
+	/**
+	 * Owns the worker thread and stops it on destruction.
+	 * Destroying a joinable std::thread terminates the program, this happens
+	 * when exit() is called while the worker runs, e.g. by Output::Error.
+	 */
+	struct Worker {
+		std::thread thread;
+
+		~Worker() {
+			Stop();
+		}
+
+		void Start() {
+			if (!thread.joinable()) {
+				thread = std::thread(WorkerMain);
+			}
+		}
+
+		void Stop() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+				jobs.clear();
+				cv.notify_all();
+			}
+			if (thread.joinable()) {
+				thread.join();
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = false;
+		}
+	};
+
+	Worker& GetWorker() {
+		// Constructed on first use, so it is destroyed before the other globals
+		static Worker worker;
+		return worker;
+	}
+#endif
+}
+
+uint32_t FileHash::CRC32(std::istream& is) {
+	auto* fis = dynamic_cast<Filesystem_Stream::InputStream*>(&is);
+	if (fis) {
+		auto data = fis->GetMemoryData();
+		auto pos = is.tellg();
+		if (!data.empty() && pos >= 0 && static_cast<size_t>(pos) <= data.size()) {
+			const uint8_t* p = data.data() + static_cast<size_t>(pos);
+			size_t len = data.size() - static_cast<size_t>(pos);
+
+			uLong crc = crc32(0L, Z_NULL, 0);
+			while (len > 0) {
+				uInt chunk = static_cast<uInt>(std::min<size_t>(len, UINT_MAX));
+				crc = crc32(crc, p, chunk);
+				p += chunk;
+				len -= chunk;
+			}
+			is.seekg(0, std::ios_base::end);
+			return crc;
+		}
+	}
+
+	return Utils::CRC32(is);
+}
+
+bool FileHash::GetCRC32(const std::string& path, uint32_t& crc) {
+	Platform::File file(path);
+	int64_t mtime = file.GetModificationTime();
+	int64_t size = file.GetSize();
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+#ifdef SUPPORT_THREADS
+		cv.wait(lock, [&] { return running_path != path; });
+
+		// Not started yet, hashing it directly is faster than waiting for the queue
+		jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [&](const auto& job) { return job.path == path; }), jobs.end());
+#endif
+
+		if (FindLocked(path, mtime, size, crc)) {
+			return true;
+		}
+	}
+
+	auto is = FileFinder::OpenMappedInputStream(path);
+	if (!is) {
+		return false;
+	}
+	crc = CRC32(is);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	AddLocked(path, mtime, size, crc);
+	return true;
+}
+
+void FileHash::Prefetch(const std::string& path) {
+#ifdef SUPPORT_THREADS
+	Platform::File file(path);
+	int64_t mtime = file.GetModificationTime();
+	int64_t size = file.GetSize();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		uint32_t crc;
+		if (FindLocked(path, mtime, size, crc) || IsQueuedLocked(path)) {
+			return;
+		}
+	}
+
+	// Opened here because FileFinder is not thread-safe
+	auto is = FileFinder::OpenMappedInputStream(path);
+	if (!is) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	jobs.push_back({ path, std::move(is), mtime, size });
+	GetWorker().Start();
+	cv.notify_all();
+#else
+	(void)path;
+#endif
+}
+
+void FileHash::Clear() {
+#ifdef SUPPORT_THREADS
+	GetWorker().Stop();
+#endif
+
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+}
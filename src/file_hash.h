@@ -0,0 +1,67 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_FILE_HASH_H
+#define EP_FILE_HASH_H
+
+// Headers
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * Computes and caches CRC32 checksums of files.
+ *
+ * Checksums of files are cached per path and stay valid as long as the
+ * modification time and the size of the file do not change. Files can be
+ * hashed by a background thread ahead of time, e.g. while the same file is
+ * parsed. On platforms without thread support the file is hashed when the
+ * checksum is requested.
+ */
+namespace FileHash {
+	/**
+	 * Calculates the CRC32 of the remaining stream content.
+	 * Memory backed streams are hashed without copying the data.
+	 *
+	 * @param is stream to hash
+	 * @return crc32
+	 */
+	uint32_t CRC32(std::istream& is);
+
+	/**
+	 * Provides the CRC32 of a file. Waits when the file is currently hashed
+	 * by the background thread.
+	 *
+	 * @param path path of the file
+	 * @param crc receives the checksum
+	 * @return false when the file is not readable
+	 */
+	bool GetCRC32(const std::string& path, uint32_t& crc);
+
+	/**
+	 * Queues a file for hashing by the background thread.
+	 * Files which are already cached or queued are ignored.
+	 *
+	 * @param path path of the file
+	 */
+	void Prefetch(const std::string& path);
+
+	/** Cancels all queued files, stops the background thread and clears the cache */
+	void Clear();
+}
+
+#endif
@@ -37,12 +37,15 @@
 #include "utils.h"
 #include "filefinder.h"
 #include "fileext_guesser.h"
+#include "filesystem_archive.h"
+#include "mapped_file.h"
 #include "output.h"
 #include "player.h"
 #include "registry.h"
 #include "main_data.h"
 #include <lcf/reader_util.h>
 #include "platform.h"
+#include "save_writer.h"
 
 // MinGW shlobj.h does not define this
 #ifndef SHGFP_TYPE_CURRENT
@@ -69,6 +72,14 @@ std::unique_ptr<DirectoryTree> FileFinder::CreateSaveDirectoryTree() {
 
 void FileFinder::SetDirectoryTree(std::unique_ptr<DirectoryTree> directory_tree) {
 	game_directory_tree = std::move(directory_tree);
+
+	if (game_directory_tree && !Player::directory_index_path.empty()) {
+		auto is = OpenInputStream(Player::directory_index_path, std::ios_base::in);
+		if (is) {
+			int loaded = game_directory_tree->ReadIndex(is);
+			Output::Debug("Directory index: Using {} cached directories", loaded);
+		}
+	}
 }
 
 std::unique_ptr<DirectoryTree> FileFinder::CreateDirectoryTree(std::string p) {
@@ -261,11 +272,24 @@ std::string FileFinder::FindFont(StringView name) {
 }
 
 void FileFinder::Quit() {
+	if (game_directory_tree && !Player::directory_index_path.empty()) {
+		auto os = OpenOutputStream(Player::directory_index_path, std::ios_base::out);
+		if (!os || !game_directory_tree->WriteIndex(os)) {
+			Output::Warning("Directory index: Writing {} failed", Player::directory_index_path);
+		}
+	}
+
 	game_directory_tree.reset();
+	ArchiveFilesystem::UnmountAll();
 }
 
 
 Filesystem_Stream::InputStream FileFinder::OpenInputStream(const std::string& name, std::ios_base::openmode m) {
+	Filesystem_Stream::InputStream archive_is;
+	if (ArchiveFilesystem::OpenMounted(name, archive_is)) {
+		return archive_is;
+	}
+
 	auto* buf = new std::filebuf();
 	buf->open(
 #ifdef _MSC_VER
@@ -284,6 +308,18 @@ Filesystem_Stream::InputStream FileFinder::OpenInputStream(const std::string& na
 	return is;
 }
 
+Filesystem_Stream::InputStream FileFinder::OpenMappedInputStream(const std::string& name) {
+	// Files inside game archives are not mapped directly, they are handled by OpenInputStream
+	auto mf = MappedFile::Open(name);
+	if (!mf) {
+		return OpenInputStream(name);
+	}
+
+	const uint8_t* data = mf->data();
+	size_t size = mf->size();
+	return Filesystem_Stream::InputStream(new Filesystem_Stream::MemoryStreamBuf(std::move(mf), data, size));
+}
+
 Filesystem_Stream::OutputStream FileFinder::OpenOutputStream(const std::string& name, std::ios_base::openmode m) {
 	auto* buf = new std::filebuf();
 	buf->open(
@@ -343,6 +379,9 @@ bool FileFinder::HasSavegame() {
 }
 
 int FileFinder::GetSavegames() {
+	// Savegames written in the background must be visible
+	SaveWriter::Flush();
+
 	auto tree = FileFinder::CreateSaveDirectoryTree();
 
 	for (int i = 1; i <= 15; i++) {
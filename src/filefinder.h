@@ -109,6 +109,18 @@ namespace FileFinder {
 	Filesystem_Stream::InputStream OpenInputStream(const std::string& name,
 			std::ios_base::openmode m = std::ios_base::in | std::ios_base::binary);
 
+	/**
+	 * Creates a binary stream from UTF-8 file name which is served from a
+	 * memory mapping when supported, readers can then access the data without
+	 * copying it (see InputStream::GetMemoryData).
+	 * Only for short reads of game files: On Windows a mapped file cannot be
+	 * written and on POSIX a file truncated while mapped crashes the Player.
+	 *
+	 * @param name UTF-8 string file name.
+	 * @return NULL if open failed.
+	 */
+	Filesystem_Stream::InputStream OpenMappedInputStream(const std::string& name);
+
 	/**
 	* Creates stream from UTF-8 file name.
 	*
@@ -285,9 +285,31 @@ std::string FileFinder_RTP::LookupInternal(StringView dir, StringView name, Span
 std::string FileFinder_RTP::Lookup(StringView dir, StringView name, Span<StringView> exts) const {
 	if (!disable_rtp) {
 		bool is_rtp_asset;
-		auto ret = LookupInternal(lcf::ReaderUtil::Normalize(dir), lcf::ReaderUtil::Normalize(name), exts, is_rtp_asset);
-
 		std::string lcase = lcf::ReaderUtil::Normalize(dir);
+		std::string lname = lcf::ReaderUtil::Normalize(name);
+
+		std::string key = lcase + '/' + lname;
+		for (const auto& ext : exts) {
+			key += '\0';
+			key.append(ext.data(), ext.size());
+		}
+
+		std::string ret;
+		auto it = lookup_cache.find(key);
+		if (it != lookup_cache.end()) {
+			ret = it->second.path;
+			is_rtp_asset = it->second.is_rtp_asset;
+		} else {
+			auto num_game_rtp = game_rtp.size();
+			ret = LookupInternal(lcase, lname, exts, is_rtp_asset);
+
+			// The result depends on the detected game RTP, invalidate when the candidates changed
+			if (game_rtp.size() != num_game_rtp) {
+				lookup_cache.clear();
+			}
+			lookup_cache[key] = { ret, is_rtp_asset };
+		}
+
 		bool is_audio_asset = lcase == "music" || lcase == "sound";
 
 		if (is_rtp_asset) {
@@ -18,6 +18,8 @@
 #ifndef EP_FILEFINDER_RTP_H
 #define EP_FILEFINDER_RTP_H
 
+#include <string>
+#include <unordered_map>
 #include "directory_tree.h"
 #include "rtp.h"
 #include "string_view.h"
@@ -61,6 +63,13 @@ private:
 	std::vector<RTP::RtpHitInfo> detected_rtp;
 	/** the RTP the game uses, when only one left the RTP of the game is known */
 	mutable std::vector<RTP::Type> game_rtp;
+
+	struct CachedLookup {
+		std::string path;
+		bool is_rtp_asset;
+	};
+	/** results of previous lookups, key is "dir/name" followed by the extensions */
+	mutable std::unordered_map<std::string, CachedLookup> lookup_cache;
 };
 
 #endif
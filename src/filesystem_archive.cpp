@@ -0,0 +1,392 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "filesystem_archive.h"
+#include "filefinder.h"
+#include "mapped_file.h"
+#include "output.h"
+#include "platform.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <streambuf>
+#include <unordered_set>
+#include <zlib.h>
+
+namespace {
+	constexpr char archive_magic[4] = { 'E', 'P', 'A', 'R' };
+	constexpr uint32_t archive_version = 1;
+	// magic, version, entry count, reserved, index offset
+	constexpr size_t header_size = 4 + 4 + 4 + 4 + 8;
+
+	constexpr uint8_t flag_compressed = 1;
+
+	// Deflate cannot compress better than 1032:1
+	constexpr uint64_t max_deflate_ratio = 1032;
+	// Files are inflated into memory, larger sizes in the index are corrupted
+	constexpr uint64_t max_inflated_size = 512 * 1024 * 1024;
+
+	// Formats which are already compressed, deflate would only waste time
+	constexpr StringView stored_types[] = {
+		".png", ".ogg", ".mp3", ".opus", ".wma", ".xyz", ".avi", ".mpg", ".jpg", ".zip", ".gz"
+	};
+
+	template <typename T>
+	void WriteLE(std::ostream& os, T value) {
+		char buf[sizeof(T)];
+		for (size_t i = 0; i < sizeof(T); ++i) {
+			buf[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+		}
+		os.write(buf, sizeof(T));
+	}
+
+	template <typename T>
+	bool ReadLE(const uint8_t*& iter, const uint8_t* end, T& value) {
+		if (static_cast<size_t>(end - iter) < sizeof(T)) {
+			return false;
+		}
+		value = 0;
+		for (size_t i = 0; i < sizeof(T); ++i) {
+			value |= static_cast<T>(iter[i]) << (i * 8);
+		}
+		iter += sizeof(T);
+		return true;
+	}
+
+	bool IsSeparator(char c) {
+#ifdef _WIN32
+		return c == '/' || c == '\\';
+#else
+		return c == '/';
+#endif
+	}
+
+	/**
+	 * Archive paths are '/' separated, but paths built with FileFinder::MakePath
+	 * use '\' on Windows.
+	 *
+	 * @param path Path in the archive
+	 * @return lookup key of the path
+	 */
+	std::string MakeKey(StringView path) {
+		std::string key = Utils::LowerCase(path);
+		std::replace_if(key.begin(), key.end(), IsSeparator, '/');
+		return key;
+	}
+
+	std::string ParentDirectory(StringView path) {
+		auto pos = path.rfind('/');
+		return pos == StringView::npos ? std::string() : ToString(path.substr(0, pos));
+	}
+
+	void CollectFiles(const std::string& root, const std::string& sub, std::vector<std::string>& files) {
+		std::string full_path = sub.empty() ? root : FileFinder::MakePath(root, sub);
+		Platform::Directory dir(full_path);
+		if (!dir) {
+			Output::Warning("Archive: Cannot open directory {}", full_path);
+			return;
+		}
+
+		while (dir.Read()) {
+			auto name = dir.GetEntryName();
+			if (name == "." || name == "..") {
+				continue;
+			}
+
+			auto sub_name = sub.empty() ? name : sub + "/" + name;
+			auto type = dir.GetEntryType();
+			if (type == Platform::FileType::Unknown) {
+				type = Platform::File(FileFinder::MakePath(full_path, name)).GetType(true);
+			}
+
+			if (type == Platform::FileType::Directory) {
+				CollectFiles(root, sub_name, files);
+			} else if (type == Platform::FileType::File) {
+				files.push_back(std::move(sub_name));
+			}
+		}
+	}
+
+	std::vector<std::pair<std::string, std::shared_ptr<ArchiveFilesystem>>> mounts;
+}
+
+std::shared_ptr<ArchiveFilesystem> ArchiveFilesystem::Open(const std::string& path) {
+	auto is = FileFinder::OpenInputStream(path, std::ios_base::in | std::ios_base::binary);
+	if (!is) {
+		return nullptr;
+	}
+
+	// DirectoryTree::Create passes every file here, check the magic before reading more
+	char magic[sizeof(archive_magic)];
+	if (!is.read(magic, sizeof(magic)) || memcmp(magic, archive_magic, sizeof(archive_magic)) != 0) {
+		return nullptr;
+	}
+
+	auto mf = MappedFile::Open(path);
+	if (mf) {
+		const uint8_t* data = mf->data();
+		size_t size = mf->size();
+		return Create(std::move(mf), data, size);
+	}
+
+	// No memory mapping available: Read the whole archive
+	is.seekg(0);
+	auto buffer = std::make_shared<std::vector<uint8_t>>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+	const uint8_t* data = buffer->data();
+	size_t size = buffer->size();
+	return Create(std::move(buffer), data, size);
+}
+
+std::shared_ptr<ArchiveFilesystem> ArchiveFilesystem::Create(std::shared_ptr<const void> owner, const uint8_t* data, size_t size) {
+	std::shared_ptr<ArchiveFilesystem> archive(new ArchiveFilesystem());
+	archive->owner = std::move(owner);
+	archive->data = data;
+	archive->size = size;
+
+	if (!archive->ReadIndex()) {
+		return nullptr;
+	}
+	return archive;
+}
+
+bool ArchiveFilesystem::ReadIndex() {
+	if (size < header_size || memcmp(data, archive_magic, sizeof(archive_magic)) != 0) {
+		return false;
+	}
+
+	const uint8_t* iter = data + sizeof(archive_magic);
+	const uint8_t* end = data + size;
+
+	uint32_t version = 0, count = 0, reserved = 0;
+	uint64_t index_offset = 0;
+	ReadLE(iter, end, version);
+	ReadLE(iter, end, count);
+	ReadLE(iter, end, reserved);
+	ReadLE(iter, end, index_offset);
+
+	if (version != archive_version) {
+		Output::Debug("Archive: Unsupported version {}", version);
+		return false;
+	}
+	if (index_offset < header_size || index_offset > size) {
+		return false;
+	}
+
+	iter = data + index_offset;
+	entries.reserve(count);
+
+	std::unordered_set<std::string> known_dirs;
+	known_dirs.insert("");
+	dir_lookup[""];
+
+	for (uint32_t i = 0; i < count; ++i) {
+		Entry entry;
+		uint16_t name_len = 0;
+		uint8_t flags = 0;
+		if (!ReadLE(iter, end, name_len) || static_cast<size_t>(end - iter) < name_len) {
+			return false;
+		}
+		entry.name.assign(reinterpret_cast<const char*>(iter), name_len);
+		iter += name_len;
+
+		if (!ReadLE(iter, end, flags) ||
+				!ReadLE(iter, end, entry.offset) ||
+				!ReadLE(iter, end, entry.size) ||
+				!ReadLE(iter, end, entry.stored_size)) {
+			return false;
+		}
+		entry.compressed = (flags & flag_compressed) != 0;
+
+		if (entry.name.empty() || entry.offset > size || entry.stored_size > size - entry.offset) {
+			return false;
+		}
+		if (entry.compressed) {
+			if (entry.size > max_inflated_size || entry.size > entry.stored_size * max_deflate_ratio) {
+				Output::Debug("Archive: {} has an invalid size {}", entry.name, entry.size);
+				return false;
+			}
+		} else if (entry.size != entry.stored_size) {
+			return false;
+		}
+
+		auto key = MakeKey(entry.name);
+		file_lookup[key] = entries.size();
+
+		// Register the file and all parent directories
+		std::string child = entry.name;
+		auto type = DirectoryTree::FileType::Regular;
+		for (;;) {
+			auto parent = ParentDirectory(child);
+			auto child_name = parent.empty() ? child : child.substr(parent.size() + 1);
+			dir_lookup[MakeKey(parent)].emplace_back(child_name, type);
+
+			if (!known_dirs.insert(MakeKey(parent)).second) {
+				break;
+			}
+			child = std::move(parent);
+			type = DirectoryTree::FileType::Directory;
+		}
+
+		entries.push_back(std::move(entry));
+	}
+
+	return true;
+}
+
+const ArchiveFilesystem::Entry* ArchiveFilesystem::FindEntry(StringView path) const {
+	auto it = file_lookup.find(MakeKey(path));
+	if (it == file_lookup.end()) {
+		return nullptr;
+	}
+	return &entries[it->second];
+}
+
+bool ArchiveFilesystem::ListDirectory(StringView path, std::vector<DirectoryTree::Entry>& dir_entries) const {
+	auto it = dir_lookup.find(MakeKey(path));
+	if (it == dir_lookup.end()) {
+		return false;
+	}
+	dir_entries = it->second;
+	return true;
+}
+
+Filesystem_Stream::InputStream ArchiveFilesystem::OpenInputStream(StringView path) const {
+	const Entry* entry = FindEntry(path);
+	if (!entry) {
+		return Filesystem_Stream::InputStream();
+	}
+
+	const uint8_t* stored = data + entry->offset;
+
+	if (!entry->compressed) {
+		return Filesystem_Stream::InputStream(new Filesystem_Stream::MemoryStreamBuf(owner, stored, entry->stored_size));
+	}
+
+	auto buffer = std::make_shared<std::vector<uint8_t>>(entry->size);
+	uLongf dest_len = static_cast<uLongf>(entry->size);
+	int res = uncompress(buffer->data(), &dest_len, stored, static_cast<uLong>(entry->stored_size));
+	if (res != Z_OK || dest_len != entry->size) {
+		Output::Warning("Archive: {} is corrupted", entry->name);
+		return Filesystem_Stream::InputStream();
+	}
+
+	const uint8_t* inflated = buffer->data();
+	return Filesystem_Stream::InputStream(new Filesystem_Stream::MemoryStreamBuf(std::move(buffer), inflated, entry->size));
+}
+
+bool ArchiveFilesystem::Pack(const std::string& directory, std::ostream& os) {
+	std::vector<std::string> files;
+	CollectFiles(directory, "", files);
+	std::sort(files.begin(), files.end());
+
+	// Header is written again when the index offset is known
+	std::vector<char> header(header_size);
+	os.write(header.data(), header.size());
+
+	std::vector<Entry> packed;
+	uint64_t offset = header_size;
+
+	for (const auto& file: files) {
+		if (file.size() > UINT16_MAX) {
+			Output::Warning("Archive: Skipping {}, path too long", file);
+			continue;
+		}
+
+		auto is = FileFinder::OpenInputStream(FileFinder::MakePath(directory, file), std::ios_base::in | std::ios_base::binary);
+		if (!is) {
+			Output::Warning("Archive: Cannot read {}", file);
+			continue;
+		}
+		std::vector<uint8_t> contents((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+		Entry entry;
+		entry.name = file;
+		entry.offset = offset;
+		entry.size = contents.size();
+
+		auto lower_name = Utils::LowerCase(file);
+		bool store = std::any_of(std::begin(stored_types), std::end(stored_types), [&](StringView ext) {
+			return ToStringView(lower_name).ends_with(ext);
+		});
+
+		std::vector<uint8_t> compressed;
+		if (!store && !contents.empty() && contents.size() <= max_inflated_size) {
+			uLongf compressed_len = compressBound(static_cast<uLong>(contents.size()));
+			compressed.resize(compressed_len);
+			if (compress2(compressed.data(), &compressed_len, contents.data(), static_cast<uLong>(contents.size()), Z_BEST_COMPRESSION) == Z_OK
+					&& compressed_len < contents.size() - contents.size() / 16) {
+				compressed.resize(compressed_len);
+				entry.compressed = true;
+			}
+		}
+
+		const auto& out = entry.compressed ? compressed : contents;
+		entry.stored_size = out.size();
+		os.write(reinterpret_cast<const char*>(out.data()), out.size());
+		offset += out.size();
+
+		packed.push_back(std::move(entry));
+	}
+
+	for (const auto& entry: packed) {
+		WriteLE<uint16_t>(os, static_cast<uint16_t>(entry.name.size()));
+		os.write(entry.name.data(), entry.name.size());
+		WriteLE<uint8_t>(os, entry.compressed ? flag_compressed : 0);
+		WriteLE<uint64_t>(os, entry.offset);
+		WriteLE<uint64_t>(os, entry.size);
+		WriteLE<uint64_t>(os, entry.stored_size);
+	}
+
+	os.seekp(0);
+	os.write(archive_magic, sizeof(archive_magic));
+	WriteLE<uint32_t>(os, archive_version);
+	WriteLE<uint32_t>(os, static_cast<uint32_t>(packed.size()));
+	WriteLE<uint32_t>(os, 0);
+	WriteLE<uint64_t>(os, offset);
+	os.seekp(0, std::ios_base::end);
+
+	return static_cast<bool>(os);
+}
+
+void ArchiveFilesystem::Mount(std::string path, std::shared_ptr<ArchiveFilesystem> archive) {
+	auto it = std::find_if(mounts.begin(), mounts.end(), [&](const auto& m) { return m.first == path; });
+	if (it != mounts.end()) {
+		it->second = std::move(archive);
+	} else {
+		mounts.emplace_back(std::move(path), std::move(archive));
+	}
+}
+
+bool ArchiveFilesystem::OpenMounted(StringView path, Filesystem_Stream::InputStream& is) {
+	for (const auto& mount: mounts) {
+		const auto& root = mount.first;
+		if (path.size() > root.size() && IsSeparator(path[root.size()]) && path.starts_with(root)) {
+			is = mount.second->OpenInputStream(path.substr(root.size() + 1));
+			return true;
+		}
+	}
+	return false;
+}
+
+void ArchiveFilesystem::UnmountAll() {
+	mounts.clear();
+}
@@ -0,0 +1,156 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_FILESYSTEM_ARCHIVE_H
+#define EP_FILESYSTEM_ARCHIVE_H
+
+// Headers
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "directory_tree.h"
+#include "filesystem.h"
+#include "filesystem_stream.h"
+#include "string_view.h"
+
+/**
+ * Read-only filesystem backed by a single archive file.
+ *
+ * The archive starts with a header followed by the file data and ends
+ * with an index of all files. Files which are already compressed (images,
+ * music) are stored and read without copying out of the memory mapped
+ * archive, other files are deflate compressed individually.
+ * Lookups are case insensitive, on Windows '\' is accepted as a path separator.
+ */
+class ArchiveFilesystem : public Filesystem {
+public:
+	/** A file in the archive */
+	struct Entry {
+		/** Path of the file with unmodified case, '/' separated */
+		std::string name;
+		/** Offset of the data from the start of the archive */
+		uint64_t offset = 0;
+		/** Size of the uncompressed file */
+		uint64_t size = 0;
+		/** Size of the data in the archive */
+		uint64_t stored_size = 0;
+		/** Whether the data is deflate compressed */
+		bool compressed = false;
+	};
+
+	/**
+	 * Opens an archive file. The file is memory mapped when supported,
+	 * otherwise it is read into memory.
+	 *
+	 * @param path Path to the archive
+	 * @return archive or nullptr when the file is not a valid archive
+	 */
+	static std::shared_ptr<ArchiveFilesystem> Open(const std::string& path);
+
+	/**
+	 * Opens an archive which is already in memory.
+	 *
+	 * @param owner Keeps the memory alive as long as the archive or streams of it exist
+	 * @param data Archive contents
+	 * @param size Size of the archive
+	 * @return archive or nullptr when the data is not a valid archive
+	 */
+	static std::shared_ptr<ArchiveFilesystem> Create(std::shared_ptr<const void> owner, const uint8_t* data, size_t size);
+
+	/**
+	 * Packs all files of a directory (recursively) into an archive.
+	 *
+	 * @param directory Directory to pack
+	 * @param os Seekable stream to write the archive to
+	 * @return true on success
+	 */
+	static bool Pack(const std::string& directory, std::ostream& os);
+
+	/**
+	 * Does a case insensitive search for a file.
+	 *
+	 * @param path Path of the file in the archive
+	 * @return entry or nullptr when not found
+	 */
+	const Entry* FindEntry(StringView path) const;
+
+	/**
+	 * Enumerates a directory of the archive.
+	 *
+	 * @param path Directory in the archive, empty for the root
+	 * @param[out] entries Files and subdirectories in the directory
+	 * @return true when the directory exists
+	 */
+	bool ListDirectory(StringView path, std::vector<DirectoryTree::Entry>& entries) const;
+
+	/**
+	 * Opens a file of the archive for reading.
+	 * Stored files are read directly out of the archive memory.
+	 *
+	 * @param path Path of the file in the archive
+	 * @return stream, evaluates to false when the file does not exist or is corrupted
+	 */
+	Filesystem_Stream::InputStream OpenInputStream(StringView path) const;
+
+	/** @return all files in the archive */
+	const std::vector<Entry>& GetEntries() const;
+
+	/**
+	 * Makes an archive available for FileFinder under its path, e.g.
+	 * "game.easyrpg/Picture/a.png" is then read from the archive.
+	 *
+	 * @param path Path of the archive file
+	 * @param archive Archive to mount
+	 */
+	static void Mount(std::string path, std::shared_ptr<ArchiveFilesystem> archive);
+
+	/**
+	 * Opens a file of a mounted archive.
+	 *
+	 * @param path Path starting with the path of a mounted archive
+	 * @param[out] is Stream of the file
+	 * @return true when the path belongs to a mounted archive
+	 */
+	static bool OpenMounted(StringView path, Filesystem_Stream::InputStream& is);
+
+	/** Unmounts all archives */
+	static void UnmountAll();
+
+private:
+	ArchiveFilesystem() = default;
+
+	bool ReadIndex();
+
+	std::shared_ptr<const void> owner;
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+
+	std::vector<Entry> entries;
+	/** lowered file path -> index in entries */
+	std::unordered_map<std::string, size_t> file_lookup;
+	/** lowered directory path -> contents */
+	std::unordered_map<std::string, std::vector<DirectoryTree::Entry>> dir_lookup;
+};
+
+inline const std::vector<ArchiveFilesystem::Entry>& ArchiveFilesystem::GetEntries() const {
+	return entries;
+}
+
+#endif
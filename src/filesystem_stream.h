@@ -20,11 +20,60 @@
 
 // Headers
 #include <cassert>
+#include <cstdint>
 #include <istream>
+#include <memory>
 #include <ostream>
+#include "span.h"
 #include "utils.h"
 
 namespace Filesystem_Stream {
+	/**
+	 * Read-only stream buffer over a memory region, e.g. a memory mapped file.
+	 * The owner keeps the memory alive as long as the buffer exists.
+	 */
+	class MemoryStreamBuf final : public std::streambuf {
+	public:
+		MemoryStreamBuf(std::shared_ptr<const void> owner, const uint8_t* data, size_t size) : owner(std::move(owner)) {
+			// The get area is never written to
+			char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+			setg(begin, begin, begin + size);
+		}
+
+		/** @return the whole memory region */
+		Span<const uint8_t> GetData() const {
+			return Span<const uint8_t>(reinterpret_cast<const uint8_t*>(eback()), egptr() - eback());
+		}
+
+	protected:
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+			if (!(which & std::ios_base::in)) {
+				return pos_type(off_type(-1));
+			}
+
+			off_type base = 0;
+			if (dir == std::ios_base::cur) {
+				base = gptr() - eback();
+			} else if (dir == std::ios_base::end) {
+				base = egptr() - eback();
+			}
+
+			off_type pos = base + off;
+			if (pos < 0 || pos > egptr() - eback()) {
+				return pos_type(off_type(-1));
+			}
+			setg(eback(), eback() + pos, egptr());
+			return pos_type(pos);
+		}
+
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+			return seekoff(off_type(pos), std::ios_base::beg, which);
+		}
+
+	private:
+		std::shared_ptr<const void> owner;
+	};
+
 	class InputStream final : public std::istream {
 	public:
 		explicit InputStream(): std::istream(nullptr) {}
@@ -39,16 +88,27 @@ namespace Filesystem_Stream {
 			is.set_rdbuf(nullptr);
 		}
 		InputStream& operator=(InputStream&& is) {
-			if (this == &is) return is;
+			if (this == &is) return *this;
+			delete rdbuf();
 			std::istream::operator=(std::move(is));
 			set_rdbuf(is.rdbuf());
 			is.set_rdbuf(nullptr);
-			return is;
+			return *this;
 		}
 
 		template <typename T>
 		bool ReadIntoObj(T& obj);
 
+		/**
+		 * Direct access to the contents when the stream is backed by memory
+		 * (a memory mapped file or a file inside a game archive).
+		 * Allows parsing without copying the data.
+		 *
+		 * @return all bytes of the stream, independent of the read position,
+		 *         or an empty span when the stream is not backed by memory
+		 */
+		Span<const uint8_t> GetMemoryData() const;
+
 	private:
 		template <typename T>
 		bool Read0(T& obj);
@@ -68,11 +128,12 @@ namespace Filesystem_Stream {
 			os.set_rdbuf(nullptr);
 		}
 		OutputStream& operator=(OutputStream&& os) noexcept {
-			if (this == &os) return os;
+			if (this == &os) return *this;
+			delete rdbuf();
 			std::ostream::operator=(std::move(os));
 			set_rdbuf(os.rdbuf());
 			os.set_rdbuf(nullptr);
-			return os;
+			return *this;
 		}
 	};
 
@@ -81,6 +142,11 @@ namespace Filesystem_Stream {
 	static constexpr int CppSeekdirToCSeekdir(std::ios_base::seekdir origin);
 };
 
+inline Span<const uint8_t> Filesystem_Stream::InputStream::GetMemoryData() const {
+	auto* buf = dynamic_cast<const MemoryStreamBuf*>(rdbuf());
+	return buf ? buf->GetData() : Span<const uint8_t>();
+}
+
 template<typename T>
 inline bool Filesystem_Stream::InputStream::Read0(T& obj) {
 	return read(reinterpret_cast<char*>(&obj), sizeof(obj)).gcount() == sizeof(obj);
@@ -16,8 +16,14 @@
  */
 
 // Headers
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <list>
 #include <map>
+#include <memory>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include <iterator>
 
@@ -46,53 +52,180 @@
 
 // Static variables.
 namespace {
-    template <typename T>
-	BitmapFontGlyph const* find_glyph(const T& glyphset, char32_t code) {
-		auto iter = std::lower_bound(std::begin(glyphset), std::end(glyphset), code);
-		if(iter != std::end(glyphset) && iter->code == code) {
-			return &*iter;
-		} else {
-			return NULL;
+	/**
+	 * Two-level lookup table (high byte, then low byte of the code point)
+	 * which merges the glyph sets of a font and of all its fallback fonts.
+	 * The built-in glyph sets only contain the Basic Multilingual Plane.
+	 */
+	class GlyphTable {
+	public:
+		template <typename... T>
+		explicit GlyphTable(const T&... glyphsets) {
+			// Glyph sets added first take precedence
+			(void)std::initializer_list<int>{ (Add(glyphsets), 0)... };
 		}
-	}
 
-	// This is the last-resort function for finding a glyph, all the other fonts should fallback on it.
-	// It tries to display a WenQuanYi glyph, and if it’s not found, returns a replacement glyph.
-	BitmapFontGlyph const* find_fallback_glyph(char32_t code) {
-		auto* wqy = find_glyph(BITMAPFONT_WQY, code);
-		if (wqy != NULL) {
-			return wqy;
+		BitmapFontGlyph const* Find(char32_t code) const {
+			if (EP_UNLIKELY(code > 0xFFFF)) {
+				return nullptr;
+			}
+			auto& page = pages[code >> 8];
+			return page ? (*page)[code & 0xFF] : nullptr;
 		}
-		else {
-			static BitmapFontGlyph const replacement_glyph = { 65533, true, { 96, 240, 504, 924, 1902, 3967, 4031, 1982, 1020, 440, 240, 96 } };
-			Output::Debug("glyph not found: {:#x}", uint32_t(code));
-			return &replacement_glyph;
+
+	private:
+		using Page = std::array<BitmapFontGlyph const*, 256>;
+
+		template <typename T>
+		void Add(const T& glyphset) {
+			for (auto& glyph: glyphset) {
+				auto& page = pages[glyph.code >> 8];
+				if (!page) {
+					page = std::make_unique<Page>();
+					page->fill(nullptr);
+				}
+				auto& entry = (*page)[glyph.code & 0xFF];
+				if (!entry) {
+					entry = &glyph;
+				}
+			}
 		}
+
+		std::array<std::unique_ptr<Page>, 256> pages;
+	};
+
+	// This is the last-resort function for finding a glyph, all the other fonts should fallback on it.
+	// The WenQuanYi glyphs are part of every table, so this returns a replacement glyph.
+	BitmapFontGlyph const* find_fallback_glyph(char32_t code) {
+		Output::Debug("glyph not found: {:#x}", uint32_t(code));
+		return &BITMAPFONT_REPLACEMENT_GLYPH;
 	}
 
 	BitmapFontGlyph const* find_gothic_glyph(char32_t code) {
-		auto* gothic = find_glyph(SHINONOME_GOTHIC, code);
-		return gothic != NULL ? gothic : find_fallback_glyph(code);
+		static const GlyphTable table(SHINONOME_GOTHIC, BITMAPFONT_WQY);
+		auto* glyph = table.Find(code);
+		return EP_LIKELY(glyph != NULL) ? glyph : find_fallback_glyph(code);
 	}
 
 	BitmapFontGlyph const* find_mincho_glyph(char32_t code) {
-		auto* mincho = find_glyph(SHINONOME_MINCHO, code);
-		return mincho == NULL ? find_gothic_glyph(code) : mincho;
+		static const GlyphTable table(SHINONOME_MINCHO, SHINONOME_GOTHIC, BITMAPFONT_WQY);
+		auto* glyph = table.Find(code);
+		return EP_LIKELY(glyph != NULL) ? glyph : find_fallback_glyph(code);
 	}
 
 	BitmapFontGlyph const* find_rmg2000_glyph(char32_t code) {
-		auto* rmg2000 = find_glyph(BITMAPFONT_RMG2000, code);
-		if (rmg2000 != NULL) {
-			return rmg2000;
-		}
-
-		auto* ttyp0 = find_glyph(BITMAPFONT_TTYP0, code);
-		return ttyp0 != NULL ? ttyp0 : find_mincho_glyph(code);
+		static const GlyphTable table(BITMAPFONT_RMG2000, BITMAPFONT_TTYP0, SHINONOME_MINCHO, SHINONOME_GOTHIC, BITMAPFONT_WQY);
+		auto* glyph = table.Find(code);
+		return EP_LIKELY(glyph != NULL) ? glyph : find_fallback_glyph(code);
 	}
 
 	BitmapFontGlyph const* find_ttyp0_glyph(char32_t code) {
-		auto* ttyp0 = find_glyph(BITMAPFONT_TTYP0, code);
-		return ttyp0 != NULL ? ttyp0 : find_gothic_glyph(code);
+		static const GlyphTable table(BITMAPFONT_TTYP0, SHINONOME_GOTHIC, BITMAPFONT_WQY);
+		auto* glyph = table.Find(code);
+		return EP_LIKELY(glyph != NULL) ? glyph : find_fallback_glyph(code);
+	}
+
+	/**
+	 * Stores the rasterized glyphs of a font in a single alpha bitmap.
+	 * The bitmap is divided into cells of the maximum glyph size. When all
+	 * cells are in use the least recently used glyph is evicted, this only
+	 * happens for text with many different CJK characters.
+	 */
+	class GlyphAtlas {
+	public:
+		enum { ATLAS_SIZE = 512 };
+
+		GlyphAtlas(int cell_width, int cell_height);
+
+		/**
+		 * Looks up a glyph and marks it as recently used.
+		 *
+		 * @param code glyph to search
+		 * @param rect Filled with the glyph rect in the atlas bitmap
+		 * @return whether the glyph is in the atlas
+		 */
+		bool Find(char32_t code, Rect& rect);
+
+		/**
+		 * Reserves a cell for a glyph. The caller must write the glyph pixels
+		 * into the returned rect of the atlas bitmap.
+		 *
+		 * @param code glyph to insert
+		 * @param width glyph width
+		 * @param height glyph height
+		 * @param rect Filled with the glyph rect in the atlas bitmap
+		 * @return false when the glyph is larger than a cell
+		 */
+		bool Insert(char32_t code, int width, int height, Rect& rect);
+
+		const BitmapRef& GetBitmap() const { return bitmap; }
+		int GetCellWidth() const { return cell_width; }
+		int GetCellHeight() const { return cell_height; }
+
+	private:
+		struct Entry {
+			char32_t code;
+			Rect rect;
+		};
+
+		BitmapRef bitmap;
+		int cell_width;
+		int cell_height;
+		int columns;
+		int cells;
+		int used_cells = 0;
+
+		/** Most recently used glyph first */
+		std::list<Entry> lru;
+		std::unordered_map<char32_t, std::list<Entry>::iterator> index;
+	};
+
+	GlyphAtlas::GlyphAtlas(int cell_width, int cell_height)
+		: cell_width(cell_width), cell_height(cell_height)
+	{
+		columns = std::max(1, ATLAS_SIZE / cell_width);
+		int rows = std::max(1, ATLAS_SIZE / cell_height);
+		cells = columns * rows;
+		bitmap = Bitmap::Create(nullptr, columns * cell_width, rows * cell_height, 0, DynamicFormat(8,8,0,8,0,8,0,8,0,PF::Alpha));
+	}
+
+	bool GlyphAtlas::Find(char32_t code, Rect& rect) {
+		auto it = index.find(code);
+		if (it == index.end()) {
+			return false;
+		}
+		if (it->second != lru.begin()) {
+			lru.splice(lru.begin(), lru, it->second);
+		}
+		rect = it->second->rect;
+		return true;
+	}
+
+	bool GlyphAtlas::Insert(char32_t code, int width, int height, Rect& rect) {
+		if (width > cell_width || height > cell_height) {
+			return false;
+		}
+
+		int x, y;
+		if (used_cells < cells) {
+			x = (used_cells % columns) * cell_width;
+			y = (used_cells / columns) * cell_height;
+			++used_cells;
+			lru.push_front({ code, Rect() });
+		} else {
+			// Reuse the cell of the least recently used glyph
+			auto& last = lru.back();
+			x = last.rect.x;
+			y = last.rect.y;
+			index.erase(last.code);
+			last.code = code;
+			lru.splice(lru.begin(), lru, std::prev(lru.end()));
+		}
+
+		rect = Rect(x, y, width, height);
+		lru.front().rect = rect;
+		index[code] = lru.begin();
+		return true;
 	}
 
 	struct BitmapFont : public Font {
@@ -109,7 +242,7 @@ namespace {
 
 	private:
 		function_type func;
-		BitmapRef glyph_bm;
+		std::unique_ptr<GlyphAtlas> atlas;
 	}; // class BitmapFont
 
 #ifdef HAVE_FREETYPE
@@ -142,6 +275,9 @@ namespace {
 		std::shared_ptr<std::remove_pointer<FT_Face>::type> face_;
 		std::string face_name_;
 		unsigned current_size_;
+		/** Rendered glyphs, recreated when the face or the style changes */
+		std::unique_ptr<GlyphAtlas> atlas_;
+		FT_Long atlas_style_ = 0;
 
 		bool check_face();
 	}; // class FTFont
@@ -204,23 +340,30 @@ Rect BitmapFont::GetSize(StringView txt) const {
 }
 
 Font::GlyphRet BitmapFont::Glyph(char32_t code) {
-	if (EP_UNLIKELY(!glyph_bm)) {
-		glyph_bm = Bitmap::Create(nullptr, FULL_WIDTH, HEIGHT, 0, DynamicFormat(8,8,0,8,0,8,0,8,0,PF::Alpha));
+	if (EP_UNLIKELY(!atlas)) {
+		atlas = std::make_unique<GlyphAtlas>(FULL_WIDTH, HEIGHT);
 	}
 	if (EP_UNLIKELY(Utils::IsControlCharacter(code))) {
-		return { glyph_bm, Rect(0, 0, 0, HEIGHT) };
+		return { atlas->GetBitmap(), Rect(0, 0, 0, HEIGHT) };
 	}
+
+	Rect rect;
+	if (EP_LIKELY(atlas->Find(code, rect))) {
+		return { atlas->GetBitmap(), rect };
+	}
+
 	auto glyph = func(code);
 	auto width = glyph->is_full? FULL_WIDTH : HALF_WIDTH;
+	atlas->Insert(code, width, HEIGHT, rect);
 
-	glyph_bm->Clear();
-	uint8_t* data = reinterpret_cast<uint8_t*>(glyph_bm->pixels());
-	int pitch = glyph_bm->pitch();
+	auto& bm = *atlas->GetBitmap();
+	int pitch = bm.pitch();
+	uint8_t* data = reinterpret_cast<uint8_t*>(bm.pixels()) + rect.y * pitch + rect.x;
 	for(size_t y_ = 0; y_ < HEIGHT; ++y_)
 		for(size_t x_ = 0; x_ < width; ++x_)
 			data[y_*pitch+x_] = (glyph->data[y_] & (0x1 << x_)) ? 255 : 0;
 
-	return { glyph_bm, Rect(0, 0, width, HEIGHT) };
+	return { atlas->GetBitmap(), rect };
 }
 
 #ifdef HAVE_FREETYPE
@@ -260,6 +403,11 @@ Font::GlyphRet FTFont::Glyph(char32_t glyph) {
 		return Font::Default()->Glyph(glyph);
 	}
 
+	Rect rect;
+	if (atlas_->Find(glyph, rect)) {
+		return { atlas_->GetBitmap(), rect };
+	}
+
 	if (FT_Load_Char(face_.get(), glyph, FT_LOAD_NO_BITMAP) != FT_Err_Ok) {
 		Output::Error("Couldn't load FreeType character {:#x}", uint32_t(glyph));
 	}
@@ -275,9 +423,16 @@ Font::GlyphRet FTFont::Glyph(char32_t glyph) {
 	int const width = ft_bitmap.width;
 	int const height = ft_bitmap.rows;
 
-	BitmapRef bm = Bitmap::Create(nullptr, width, height, 0, DynamicFormat(8,8,0,8,0,8,0,8,0,PF::Alpha));
-	uint8_t* data = reinterpret_cast<uint8_t*>(bm->pixels());
+	BitmapRef bm;
+	if (atlas_->Insert(glyph, width, height, rect)) {
+		bm = atlas_->GetBitmap();
+	} else {
+		// Larger than the font metrics, not cached
+		bm = Bitmap::Create(nullptr, width, height, 0, DynamicFormat(8,8,0,8,0,8,0,8,0,PF::Alpha));
+		rect = Rect(0, 0, width, height);
+	}
 	int dst_pitch = bm->pitch();
+	uint8_t* data = reinterpret_cast<uint8_t*>(bm->pixels()) + rect.y * dst_pitch + rect.x;
 
 	for(int row = 0; row < height; ++row) {
 		for(int col = 0; col < width; ++col) {
@@ -287,7 +442,7 @@ Font::GlyphRet FTFont::Glyph(char32_t glyph) {
 		}
 	}
 
-	return { bm, Rect(0, 0, width, height) };
+	return { bm, rect };
 }
 
 bool FTFont::check_face() {
@@ -329,12 +484,18 @@ bool FTFont::check_face() {
 			face_ = it->second.lock();
 		}
 		face_name_ = name;
+		atlas_.reset();
 	}
 
 	face_->style_flags =
 		(bold ? FT_STYLE_FLAG_BOLD : 0) |
 		(italic ? FT_STYLE_FLAG_ITALIC : 0);
 
+	// Rendered glyphs depend on the size and the style
+	if (current_size_ != size || atlas_style_ != face_->style_flags) {
+		atlas_.reset();
+	}
+
 	if (current_size_ != size) {
 		int sz, dpi;
 		if (face_->num_fixed_sizes == 1) {
@@ -352,6 +513,15 @@ bool FTFont::check_face() {
 		current_size_ = size;
 	}
 
+	if (!atlas_) {
+		// Leave room for glyphs exceeding the advance (e.g. italic)
+		auto const& metrics = face_->size->metrics;
+		int cell_width = (metrics.max_advance >> 6) + 2;
+		int cell_height = (metrics.height >> 6) + 2;
+		atlas_ = std::make_unique<GlyphAtlas>(std::max(cell_width, 1), std::max(cell_height, 1));
+		atlas_style_ = face_->style_flags;
+	}
+
 	return true;
 }
 #endif
@@ -408,15 +578,15 @@ Rect Font::Render(Bitmap& dest, int const x, int const y, const Bitmap& sys, int
 
 	if(color != ColorShadow) {
 		auto shadow_rect = Rect(x + 1, y + 1, rect.width, rect.height);
-		dest.MaskedBlit(shadow_rect, *gret.bitmap, 0, 0, sys, 16, 32);
+		dest.MaskedBlit(shadow_rect, *gret.bitmap, gret.rect.x, gret.rect.y, sys, 16, 32);
 	}
 
 	unsigned const
 		src_x = color == ColorShadow? 16 : color % 10 * 16 + 2,
-		src_y = color == ColorShadow? 32 : color / 10 * 16 + 48 + 16 - gret.bitmap->height();
+		src_y = color == ColorShadow? 32 : color / 10 * 16 + 48 + 16 - gret.rect.height;
 
 
-	dest.MaskedBlit(rect, *gret.bitmap, 0, 0, sys, src_x, src_y);
+	dest.MaskedBlit(rect, *gret.bitmap, gret.rect.x, gret.rect.y, sys, src_x, src_y);
 
 	return rect;
 }
@@ -425,7 +595,7 @@ Rect Font::Render(Bitmap& dest, int x, int y, Color const& color, char32_t code)
 	auto gret = Glyph(code);
 
 	auto rect = Rect(x, y, gret.rect.width, gret.rect.height);
-	dest.MaskedBlit(rect, *gret.bitmap, 0, 0, color);
+	dest.MaskedBlit(rect, *gret.bitmap, gret.rect.x, gret.rect.y, color);
 
 	return rect;
 }
@@ -436,10 +606,16 @@ ExFont::ExFont() : Font("exfont", 12, false, false) {
 FontRef Font::exfont = std::make_shared<ExFont>();
 
 Font::GlyphRet ExFont::Glyph(char32_t code) {
-	if (EP_UNLIKELY(!bm)) { bm = Bitmap::Create(WIDTH, HEIGHT, true); }
 	auto exfont = Cache::Exfont();
 
+	// The glyph is rendered directly out of the exfont image
 	Rect const rect((code % 13) * WIDTH, (code / 13) * HEIGHT, WIDTH, HEIGHT);
+	if (EP_LIKELY(rect.x + rect.width <= exfont->width() && rect.y + rect.height <= exfont->height())) {
+		return { exfont, rect };
+	}
+
+	// Custom ExFont images can be smaller, copy the part which exists
+	if (EP_UNLIKELY(!bm)) { bm = Bitmap::Create(WIDTH, HEIGHT, true); }
 	bm->Clear();
 	bm->Blit(0, 0, *exfont, rect, Opacity::Opaque());
 	return { bm, Rect(0, 0, WIDTH, HEIGHT) };
@@ -18,12 +18,14 @@
 #include <sstream>
 
 #include "fps_overlay.h"
+#include "audio.h"
 #include "game_clock.h"
 #include "bitmap.h"
 #include "utils.h"
 #include "input.h"
 #include "font.h"
 #include "drawable_mgr.h"
+#include "player.h"
 
 using namespace std::chrono_literals;
 
@@ -40,6 +42,21 @@ FpsOverlay::FpsOverlay() :
 void FpsOverlay::UpdateText() {
 	auto fps = Utils::RoundTo<int>(Game_Clock::GetFPS());
 	text = "FPS: " + std::to_string(fps);
+
+	if (Player::debug_flag) {
+		AudioStats stats = Audio().GetStats();
+		if (stats.callbacks > last_audio_stats.callbacks) {
+			AudioStats interval;
+			interval.callback_time = stats.callback_time - last_audio_stats.callback_time;
+			interval.audio_time = stats.audio_time - last_audio_stats.audio_time;
+			text += " Audio: " + std::to_string(Utils::RoundTo<int>(interval.GetLoad())) + "%";
+			if (stats.underruns > 0) {
+				text += " (" + std::to_string(stats.underruns) + " underruns)";
+			}
+		}
+		last_audio_stats = stats;
+	}
+
 	fps_dirty = true;
 }
 
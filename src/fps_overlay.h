@@ -20,6 +20,7 @@
 
 #include <deque>
 #include <string>
+#include "audio.h"
 #include "drawable.h"
 #include "memory_management.h"
 #include "rect.h"
@@ -28,6 +29,7 @@
 /**
  * FpsOverlay class.
  * Shows current FPS and the speedup indicator.
+ * In debug mode the audio load is shown as well.
  */
 class FpsOverlay : public Drawable {
 public:
@@ -69,6 +71,9 @@ private:
 
 	std::string text;
 
+	/** Audio counters of the last refresh, the load is shown per interval */
+	AudioStats last_audio_stats;
+
 	int last_speed_mod = 1;
 	bool speedup_dirty = true;
 	bool fps_dirty = true;
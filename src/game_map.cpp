@@ -42,9 +42,13 @@
 #include "output.h"
 #include "util_macro.h"
 #include "game_system.h"
+#include "file_hash.h"
 #include "filefinder.h"
 #include "player.h"
 #include "input.h"
+#include "lcf_lock.h"
+#include "lcf_snapshot.h"
+#include "map_cache.h"
 #include "utils.h"
 #include "rand.h"
 #include <lcf/scope_guard.h>
@@ -78,6 +82,7 @@ namespace {
 
 namespace Game_Map {
 void SetupCommon();
+void PreloadMaps();
 }
 
 void Game_Map::OnContinueFromBattle() {
@@ -261,6 +266,18 @@ void Game_Map::SetupFromSave(
 
 std::unique_ptr<lcf::rpg::Map> Game_Map::loadMapFile(int map_id) {
 	std::unique_ptr<lcf::rpg::Map> map;
+	// Copied while holding LcfLock, MapCache parses maps in the background
+	std::string error;
+
+	// The recording contains a hash of the map file
+	if (!Input::IsRecording()) {
+		// Cached maps are shared, the caller gets a copy it can modify
+		auto cached_map = MapCache::Get(map_id);
+		if (cached_map) {
+			Output::Debug("Loaded Map {} from cache", map_id);
+			return std::make_unique<lcf::rpg::Map>(*cached_map);
+		}
+	}
 
 	// Try loading EasyRPG map files first, then fallback to normal RPG Maker
 	// FIXME: Assert map was cached for async platforms
@@ -275,19 +292,30 @@ std::unique_ptr<lcf::rpg::Map> Game_Map::loadMapFile(int map_id) {
 			return nullptr;
 		}
 
-		auto map_stream = FileFinder::OpenInputStream(map_file);
+		auto map_stream = FileFinder::OpenMappedInputStream(map_file);
 		if (!map_stream) {
 			Output::Error("Loading of Map {} failed.\nMap not readable.", map_name);
 			return nullptr;
 		}
 
-		map = lcf::LMU_Reader::Load(map_stream, Player::encoding);
+		if (Input::IsRecording()) {
+			// Hashed in the background while the map is parsed
+			FileHash::Prefetch(map_file);
+		}
+
+		{
+			auto lcf_lock = LcfLock::Acquire();
+			map = LcfSnapshot::LoadMap(map_name, map_stream, Player::encoding);
+			if (!map) {
+				error = lcf::LcfReader::GetError();
+			}
+		}
 
 		if (Input::IsRecording()) {
-			map_stream.clear();
-			map_stream.seekg(0);
+			uint32_t crc = 0;
+			FileHash::GetCRC32(map_file, crc);
 			Input::AddRecordingData(Input::RecordingData::Hash,
-						   fmt::format("map{} {:#08x}", Utils::CRC32(map_stream)));
+						   fmt::format("map{} {:#08x}", map_id, crc));
 		}
 	} else {
 		auto map_stream = FileFinder::OpenInputStream(map_file);
@@ -295,13 +323,19 @@ std::unique_ptr<lcf::rpg::Map> Game_Map::loadMapFile(int map_id) {
 			Output::Error("Loading of Map {} failed.\nMap not readable.", map_name);
 			return nullptr;
 		}
+		auto lcf_lock = LcfLock::Acquire();
 		map = lcf::LMU_Reader::LoadXml(map_stream);
+		if (!map) {
+			error = lcf::LcfReader::GetError();
+		}
 	}
 
 	Output::Debug("Loaded Map {}", map_name);
 
 	if (map.get() == NULL) {
-		Output::ErrorStr(lcf::LcfReader::GetError());
+		Output::ErrorStr(error);
+	} else {
+		MapCache::Add(map_id, std::make_shared<lcf::rpg::Map>(*map));
 	}
 
 	return map;
@@ -336,6 +370,71 @@ void Game_Map::SetupCommon() {
 	for (const auto& ev : map->events) {
 		events.emplace_back(GetMapId(), &ev);
 	}
+
+	PreloadMaps();
+}
+
+void Game_Map::PreloadMaps() {
+#ifdef SUPPORT_THREADS
+	// Upper limit of maps queued per map change
+	constexpr size_t preload_max = 8;
+
+	if (Input::IsRecording()) {
+		return;
+	}
+
+	std::vector<int> map_ids;
+	auto add_map = [&](int map_id) {
+		if (map_id > 0 && map_id != GetMapId()
+				&& std::find(map_ids.begin(), map_ids.end(), map_id) == map_ids.end()
+				&& GetMapType(map_id) == lcf::rpg::TreeMap::MapType_map) {
+			map_ids.push_back(map_id);
+		}
+	};
+
+	// Teleport destinations of the events
+	for (const auto& ev : map->events) {
+		for (const auto& page : ev.pages) {
+			for (const auto& cmd : page.event_commands) {
+				if (cmd.code == static_cast<int>(lcf::rpg::EventCommand::Code::Teleport) && !cmd.parameters.empty()) {
+					add_map(cmd.parameters[0]);
+				}
+			}
+		}
+	}
+
+	// Neighbors in the map tree
+	add_map(GetParentId(GetMapId()));
+	for (const auto& info : lcf::Data::treemap.maps) {
+		if (info.parent_map == GetMapId()) {
+			add_map(info.ID);
+		}
+	}
+
+	if (map_ids.size() > preload_max) {
+		map_ids.resize(preload_max);
+	}
+
+	for (int map_id : map_ids) {
+		if (MapCache::Contains(map_id)) {
+			continue;
+		}
+
+		bool is_xml = true;
+		std::string map_name = ConstructMapName(map_id, true);
+		std::string map_file = FileFinder::FindDefault(map_name);
+		if (map_file.empty()) {
+			is_xml = false;
+			map_name = ConstructMapName(map_id, false);
+			map_file = FileFinder::FindDefault(map_name);
+		}
+
+		auto map_stream = map_file.empty() ? Filesystem_Stream::InputStream() : FileFinder::OpenInputStream(map_file);
+		if (map_stream) {
+			MapCache::Preload(map_id, map_name, std::move(map_stream), Player::encoding, is_xml);
+		}
+	}
+#endif
 }
 
 void Game_Map::PrepareSave(lcf::rpg::Save& save) {
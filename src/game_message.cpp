@@ -30,11 +30,73 @@
 #include <lcf/data.h>
 #include <lcf/reader_util.h>
 #include "output.h"
+#include "lru_cache.h"
+#include "text.h"
 
 #include <cctype>
+#include <tuple>
 
 static Window_Message* window = nullptr;
 
+namespace {
+	/**
+	 * Cache of the line breaks of wrapped text. Battle and help messages
+	 * wrap the same text on every refresh.
+	 * Key is font, limit and text, the value is offset and length of each
+	 * wrapped line.
+	 */
+	using WrapKey = std::tuple<const Font*, int, std::string>;
+	using WrapLines = std::vector<std::pair<int, int>>;
+
+	// Maximum amount of wrapped texts
+	constexpr size_t wrap_cache_limit = 256;
+
+	LruCache<WrapKey, WrapLines, TupleHash> wrap_cache;
+
+	WrapLines FindLineBreaks(const Font& font, StringView line, int limit) {
+		// Font widths are additive, so every word is measured only once and
+		// the width of a line is the sum of its words and the spaces between
+		const int space_width = Text::GetSize(font, " ").width;
+
+		WrapLines lines;
+		int start = 0;
+
+		do {
+			int next = start;
+			int width = 0;
+			do {
+				auto found = line.find(' ', next);
+				if (found == std::string::npos) {
+					found = line.size();
+				}
+
+				int word_width = Text::GetSize(font, line.substr(next, found - next)).width;
+				int line_width = (next == start) ? word_width : width + space_width + word_width;
+				if (line_width > limit) {
+					if (next == start) {
+						next = found + 1;
+					}
+					break;
+				}
+
+				width = line_width;
+				next = found + 1;
+			} while(next < static_cast<int>(line.size()));
+
+			if (start == (next - 1)) {
+				start = next;
+				continue;
+			}
+
+			lines.emplace_back(start, (next - 1) - start);
+
+			start = next;
+		} while (start < static_cast<int>(line.size()));
+
+		return lines;
+	}
+}
+
 void Game_Message::SetWindow(Window_Message* w) {
 	window = w;
 }
@@ -80,44 +142,23 @@ int Game_Message::GetRealPosition() {
 }
 
 int Game_Message::WordWrap(StringView line, const int limit, const WordWrapCallback& callback) {
-	int start = 0;
-	int line_count = 0;
 	FontRef font = Font::Default();
 
-	do {
-		int next = start;
-		do {
-			auto found = line.find(' ', next);
-			if (found == std::string::npos) {
-				found = line.size();
-			}
-
-			auto wrapped = line.substr(start, found - start);
-			auto width = font->GetSize(wrapped).width;
-			if (width > limit) {
-				if (next == start) {
-					next = found + 1;
-				}
-				break;
-			}
-
-			next = found + 1;
-		} while(next < static_cast<int>(line.size()));
+	WrapKey key { font.get(), limit, ToString(line) };
 
-		if (start == (next - 1)) {
-			start = next;
-			continue;
+	const WrapLines* lines = wrap_cache.Find(key);
+	if (!lines) {
+		lines = &wrap_cache.Insert(std::move(key), FindLineBreaks(*font, line, limit));
+		if (wrap_cache.Size() > wrap_cache_limit) {
+			wrap_cache.RemoveOldest();
 		}
+	}
 
-		auto wrapped = line.substr(start, (next - 1) - start);
-
-		callback(wrapped);
-		line_count++;
-
-		start = next;
-	} while (start < static_cast<int>(line.size()));
+	for (auto& l: *lines) {
+		callback(line.substr(l.first, l.second));
+	}
 
-	return line_count;
+	return static_cast<int>(lines->size());
 }
 
 AsyncOp Game_Message::Update() {
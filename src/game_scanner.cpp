@@ -0,0 +1,244 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "game_scanner.h"
+#include "filefinder.h"
+#include "options.h"
+#include "output.h"
+#include "platform.h"
+#include "system.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+
+#ifdef SUPPORT_THREADS
+#  include <atomic>
+#  include <thread>
+#endif
+
+namespace {
+	constexpr StringView cache_header = "EasyRPG GameList 1";
+
+	/** Upper limit of worker threads, more do not help on slow storage */
+	constexpr unsigned max_workers = 8;
+
+	/**
+	 * Probes all entries which are not up to date in the cache.
+	 * Runs on the workers, must only use Platform functions and must not log.
+	 */
+	void ProbeAll(const std::vector<std::string>& paths, std::vector<GameScanner::Game>& games,
+			const std::unordered_map<std::string, const GameScanner::Game*>& cached) {
+		auto probe = [&](size_t i) {
+			auto& game = games[i];
+			const std::string& path = paths[i];
+			int64_t mtime = Platform::File(path).GetModificationTime();
+
+			auto it = cached.find(game.name);
+			if (mtime != -1 && it != cached.end() && it->second->mtime == mtime) {
+				game.type = it->second->type;
+			} else {
+				game.type = GameScanner::Probe(path);
+			}
+			game.mtime = mtime;
+		};
+
+#ifdef SUPPORT_THREADS
+		unsigned num_workers = std::min<unsigned>({ std::thread::hardware_concurrency(), max_workers, static_cast<unsigned>(games.size()) });
+		if (num_workers > 1) {
+			std::atomic<size_t> next { 0 };
+			auto worker = [&]() {
+				for (size_t i = next++; i < games.size(); i = next++) {
+					probe(i);
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (unsigned i = 0; i < num_workers; ++i) {
+				threads.emplace_back(worker);
+			}
+			for (auto& thread: threads) {
+				thread.join();
+			}
+			return;
+		}
+#endif
+
+		for (size_t i = 0; i < games.size(); ++i) {
+			probe(i);
+		}
+	}
+}
+
+GameScanner::ProjectType GameScanner::Probe(const std::string& path) {
+	Platform::Directory dir(path);
+	if (!dir) {
+		return ProjectType::None;
+	}
+
+	const std::string database = Utils::LowerCase(DATABASE_NAME);
+	const std::string treemap = Utils::LowerCase(TREEMAP_NAME);
+	const std::string database_easyrpg = Utils::LowerCase(DATABASE_NAME_EASYRPG);
+	const std::string treemap_easyrpg = Utils::LowerCase(TREEMAP_NAME_EASYRPG);
+	const std::string rt_prefix = Utils::LowerCase(RPG_RT_PREFIX ".");
+
+	bool has_database = false, has_treemap = false;
+	bool has_database_easyrpg = false, has_treemap_easyrpg = false;
+	// Same heuristic as FileExtGuesser::GetRPG2kProjectWithRenames
+	int renamed_candidates = 0;
+
+	while (dir.Read()) {
+		auto type = dir.GetEntryType();
+		if (type == Platform::FileType::Unknown) {
+			type = Platform::File(path + "/" + dir.GetEntryName()).GetType(true);
+		}
+		if (type != Platform::FileType::File) {
+			continue;
+		}
+
+		std::string name = Utils::LowerCase(dir.GetEntryName());
+		has_database |= (name == database);
+		has_treemap |= (name == treemap);
+		has_database_easyrpg |= (name == database_easyrpg);
+		has_treemap_easyrpg |= (name == treemap_easyrpg);
+
+		if (name.size() == rt_prefix.size() + 3 && ToStringView(name).starts_with(rt_prefix)) {
+			std::string ext = name.substr(rt_prefix.size());
+			if (ext != "exe" && ext != "ini") {
+				++renamed_candidates;
+			}
+		}
+	}
+
+	if (has_database && has_treemap) {
+		return ProjectType::RPG2k;
+	} else if (has_database_easyrpg && has_treemap_easyrpg) {
+		return ProjectType::EasyRpg;
+	} else if (renamed_candidates == 2) {
+		return ProjectType::RPG2kWithRenames;
+	}
+	return ProjectType::None;
+}
+
+std::vector<GameScanner::Game> GameScanner::Scan(const DirectoryTree& tree, StringView cache_path) {
+	std::vector<Game> cache;
+	if (!cache_path.empty()) {
+		auto is = FileFinder::OpenInputStream(ToString(cache_path), std::ios_base::in);
+		if (is) {
+			cache = ReadCache(is, tree.GetRootPath());
+		}
+	}
+
+	std::unordered_map<std::string, const Game*> cached;
+	for (const auto& game: cache) {
+		cached[game.name] = &game;
+	}
+
+	std::vector<Game> games;
+	const auto* entries = tree.ListDirectory();
+	if (entries) {
+		for (const auto& entry: *entries) {
+			if (entry.second.type == DirectoryTree::FileType::Directory) {
+				games.emplace_back();
+				games.back().name = entry.second.name;
+			}
+		}
+	}
+
+	std::vector<std::string> paths;
+	for (const auto& game: games) {
+		paths.push_back(tree.MakePath(game.name));
+	}
+	ProbeAll(paths, games, cached);
+
+	size_t num_cached = std::count_if(games.begin(), games.end(), [&](const Game& game) {
+		auto it = cached.find(game.name);
+		return it != cached.end() && it->second->mtime == game.mtime;
+	});
+	Output::Debug("GameScanner: {} directories, {} from cache", games.size(), num_cached);
+
+	if (!cache_path.empty()) {
+		auto os = FileFinder::OpenOutputStream(ToString(cache_path), std::ios_base::out);
+		if (!os || !WriteCache(os, tree.GetRootPath(), games)) {
+			Output::Warning("GameScanner: Writing {} failed", cache_path);
+		}
+	}
+
+	games.erase(std::remove_if(games.begin(), games.end(), [](const Game& game) {
+		return !game.IsValid();
+	}), games.end());
+
+	std::sort(games.begin(), games.end(), [](const Game& a, const Game& b) {
+		return Utils::LowerCase(a.name) < Utils::LowerCase(b.name);
+	});
+
+	return games;
+}
+
+std::vector<GameScanner::Game> GameScanner::ReadCache(std::istream& is, StringView root) {
+	// Format:
+	// Header line, root path line
+	// Per directory: "<mtime> <type> <name>"
+	std::vector<Game> games;
+
+	std::string line;
+	if (!Utils::ReadLine(is, line) || line != cache_header) {
+		return games;
+	}
+	if (!Utils::ReadLine(is, line) || line != root) {
+		return games;
+	}
+
+	while (Utils::ReadLine(is, line)) {
+		auto type_pos = line.find(' ');
+		auto name_pos = (type_pos == std::string::npos) ? type_pos : line.find(' ', type_pos + 1);
+		if (name_pos == std::string::npos || name_pos + 1 >= line.size()) {
+			break;
+		}
+
+		int type = std::atoi(line.c_str() + type_pos + 1);
+		if (type < 0 || type > static_cast<int>(ProjectType::RPG2kWithRenames)) {
+			break;
+		}
+
+		Game game;
+		game.mtime = std::strtoll(line.c_str(), nullptr, 10);
+		game.type = static_cast<ProjectType>(type);
+		game.name = line.substr(name_pos + 1);
+		games.push_back(std::move(game));
+	}
+
+	return games;
+}
+
+bool GameScanner::WriteCache(std::ostream& os, StringView root, const std::vector<Game>& games) {
+	os << cache_header << "\n" << root << "\n";
+
+	for (const auto& game: games) {
+		// Names with line breaks cannot be represented, probe these directories again
+		if (game.mtime == -1 || game.name.find_first_of("\r\n") != std::string::npos) {
+			continue;
+		}
+
+		os << game.mtime << " " << static_cast<int>(game.type) << " " << game.name << "\n";
+	}
+
+	return static_cast<bool>(os);
+}
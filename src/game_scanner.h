@@ -0,0 +1,100 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_GAME_SCANNER_H
+#define EP_GAME_SCANNER_H
+
+// Headers
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "directory_tree.h"
+#include "string_view.h"
+
+/**
+ * Finds the games in the direct subdirectories of a directory, used by the
+ * game browser.
+ *
+ * The subdirectories are probed in parallel. Probing only uses Platform
+ * functions because FileFinder and Output are not thread-safe. The results
+ * can be stored in a cache file, a subdirectory is only probed again when
+ * its modification time changed.
+ */
+namespace GameScanner {
+	/** Kind of project, the same checks as FileFinder::IsValidProject */
+	enum class ProjectType {
+		None,
+		RPG2k,
+		EasyRpg,
+		RPG2kWithRenames
+	};
+
+	/** Information about a subdirectory */
+	struct Game {
+		/** name of the subdirectory */
+		std::string name;
+		ProjectType type = ProjectType::None;
+		/** Modification time of the subdirectory or -1 when unsupported */
+		int64_t mtime = -1;
+
+		/** @return true if the subdirectory contains a game */
+		bool IsValid() const {
+			return type != ProjectType::None;
+		}
+	};
+
+	/**
+	 * Finds all games in the direct subdirectories of the tree.
+	 *
+	 * @param tree directory to scan
+	 * @param cache_path path of the cache file, when empty no cache is used
+	 * @return games sorted by name, subdirectories without a game are omitted
+	 */
+	std::vector<Game> Scan(const DirectoryTree& tree, StringView cache_path);
+
+	/**
+	 * Probes a single directory for a game.
+	 * Thread-safe, does not log.
+	 *
+	 * @param path path of the directory
+	 * @return type of the project, None when no game was found
+	 */
+	ProjectType Probe(const std::string& path);
+
+	/**
+	 * Reads a cache file written by WriteCache.
+	 *
+	 * @param is input stream
+	 * @param root directory the cache must belong to
+	 * @return cached entries, empty on error or when the cache is for a different root
+	 */
+	std::vector<Game> ReadCache(std::istream& is, StringView root);
+
+	/**
+	 * Writes the cache file.
+	 * Entries without a modification time are skipped.
+	 *
+	 * @param os output stream
+	 * @param root scanned directory
+	 * @param games all probed subdirectories, including those without a game
+	 * @return true on success
+	 */
+	bool WriteCache(std::ostream& os, StringView root, const std::vector<Game>& games);
+}
+
+#endif
@@ -192,6 +192,11 @@ bool ImageBMP::ReadBMP(const uint8_t* data, unsigned len, bool transparent,
 
 bool ImageBMP::ReadBMP(Filesystem_Stream::InputStream& stream, bool transparent,
 					int& width, int& height, void*& pixels) {
+	auto data = stream.GetMemoryData();
+	if (!data.empty()) {
+		return ReadBMP(data.data(), (unsigned) data.size(), transparent, width, height, pixels);
+	}
+
 	std::vector<uint8_t> buffer = Utils::ReadStream(stream);
 	return ReadBMP(&buffer.front(), (unsigned) buffer.size(), transparent, width, height, pixels);
 }
@@ -0,0 +1,38 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_LCF_LOCK_H
+#define EP_LCF_LOCK_H
+
+// Headers
+#include <mutex>
+
+/**
+ * Serializes the use of liblcf, which is not thread-safe: The readers store
+ * the last error in a static that LcfReader::GetError returns.
+ *
+ * The lock must be held while loading or saving LCF data and until the error
+ * is read, because MapCache and SaveWriter use liblcf in the background.
+ * Do not call Output::Error while holding it: exit() joins the background
+ * threads, which can wait for the lock.
+ */
+namespace LcfLock {
+	/** @return lock of liblcf, blocks while a background thread uses it */
+	std::unique_lock<std::mutex> Acquire();
+}
+
+#endif
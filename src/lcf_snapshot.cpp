@@ -0,0 +1,206 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "lcf_snapshot.h"
+#include "file_hash.h"
+#include "filefinder.h"
+#include "main_data.h"
+#include "output.h"
+#include "platform.h"
+#include "utils.h"
+#include "version.h"
+#include <lcf/ldb/reader.h>
+#include <lcf/lmt/reader.h>
+#include <lcf/lmu/reader.h>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <zlib.h>
+
+#ifdef _WIN32
+#  include <direct.h>
+#elif !defined(PSP2)
+#  include <unistd.h>
+#endif
+
+namespace {
+	constexpr StringView snapshot_header = "EasyRPG LcfSnapshot 1";
+	constexpr StringView snapshot_ext = ".snapshot";
+
+	// A snapshot written by another liblcf can lack fields or store them differently
+#ifdef EP_LCF_VERSION
+	constexpr StringView lcf_version = EP_LCF_VERSION;
+#else
+	// liblcf is updated together with the Player, its version invalidates the snapshots
+	constexpr StringView lcf_version = "player-" PLAYER_VERSION;
+#endif
+
+	// Snapshots contain UTF-8 strings, an empty encoding skips the conversion
+	constexpr StringView snapshot_encoding = "";
+
+	// The 2k3 format is a superset of the 2k format, nothing is lost
+	constexpr auto snapshot_engine = lcf::EngineVersion::e2k3;
+
+	std::string cache_directory;
+
+	bool IsRelativePath(StringView path) {
+		// Windows drive letters and console device prefixes ("sdmc:") contain a colon
+		return !path.empty() && path[0] != '/' && path[0] != '\\' && path.find(':') == StringView::npos;
+	}
+
+	/** @return the game path, relative paths are resolved against the working directory */
+	std::string GetAbsoluteGamePath() {
+		std::string path = Main_Data::GetProjectPath();
+		if (!IsRelativePath(path)) {
+			return path;
+		}
+
+#if defined(_WIN32)
+		wchar_t* cwd = _wgetcwd(nullptr, 0);
+		if (cwd) {
+			path = FileFinder::MakePath(Utils::FromWideString(cwd), path);
+			free(cwd);
+		}
+#elif !defined(PSP2)
+		std::vector<char> cwd(4096);
+		if (getcwd(cwd.data(), cwd.size())) {
+			path = FileFinder::MakePath(cwd.data(), path);
+		}
+#endif
+		return path;
+	}
+
+	/** @param log false on background threads, Output is not thread-safe */
+	template <typename T, typename LoadFn, typename SaveFn>
+	std::unique_ptr<T> Load(LcfSnapshot::Snapshot snapshot, std::istream& is, StringView encoding, bool log, LoadFn load, SaveFn save) {
+		if (snapshot.path.empty()) {
+			return load(is, encoding);
+		}
+
+		auto crc = FileHash::CRC32(is);
+		is.clear();
+		is.seekg(0);
+
+		std::string key = fmt::format("{} {} {:08x} {}", snapshot_header, lcf_version, crc, encoding);
+
+		{
+			// Closed before the snapshot is replaced
+			auto snapshot_is = std::move(snapshot.is);
+			std::string line;
+			if (snapshot_is && Utils::ReadLine(snapshot_is, line) && line == key) {
+				auto data = load(snapshot_is, snapshot_encoding);
+				if (data) {
+					if (log) {
+						Output::Debug("LcfSnapshot: Using {}", snapshot.path);
+					}
+					return data;
+				}
+				if (log) {
+					Output::Debug("LcfSnapshot: {} is corrupted", snapshot.path);
+				}
+			}
+		}
+
+		auto data = load(is, encoding);
+		if (!data) {
+			return data;
+		}
+
+		// Written to a temporary file first, otherwise an interrupted write leaves a valid key with a truncated body
+		std::string tmp_path = snapshot.path + ".tmp";
+		bool success;
+		{
+			auto os = FileFinder::OpenOutputStream(tmp_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+			success = os && (os << key << "\n") && save(os, *data) && os.flush();
+		}
+		if (!success || !Platform::File(tmp_path).Rename(snapshot.path)) {
+			if (log) {
+				Output::Warning("LcfSnapshot: Writing {} failed", snapshot.path);
+			}
+			std::remove(tmp_path.c_str());
+		}
+
+		return data;
+	}
+
+	std::unique_ptr<lcf::rpg::Map> LoadMapSnapshot(LcfSnapshot::Snapshot snapshot, std::istream& is, StringView encoding, bool log) {
+		return Load<lcf::rpg::Map>(std::move(snapshot), is, encoding, log,
+			[](std::istream& is, StringView encoding) {
+				return lcf::LMU_Reader::Load(is, encoding);
+			},
+			[](std::ostream& os, const lcf::rpg::Map& map) {
+				return lcf::LMU_Reader::Save(os, map, snapshot_engine, snapshot_encoding);
+			});
+	}
+}
+
+void LcfSnapshot::SetCacheDirectory(std::string path) {
+	cache_directory = std::move(path);
+}
+
+const std::string& LcfSnapshot::GetCacheDirectory() {
+	return cache_directory;
+}
+
+std::string LcfSnapshot::GetSnapshotPath(StringView name) {
+	// Games share the cache directory, the hash of the game path tells them apart
+	std::string game_path = GetAbsoluteGamePath();
+	uLong crc = crc32(0L, Z_NULL, 0);
+	crc = crc32(crc, reinterpret_cast<const Bytef*>(game_path.data()), static_cast<uInt>(game_path.size()));
+
+	return FileFinder::MakePath(cache_directory, fmt::format("{:08x}_{}{}", crc, name, snapshot_ext));
+}
+
+std::unique_ptr<lcf::rpg::Database> LcfSnapshot::LoadDatabase(StringView name, std::istream& is, StringView encoding) {
+	return Load<lcf::rpg::Database>(OpenSnapshot(name), is, encoding, true,
+		[](std::istream& is, StringView encoding) {
+			return lcf::LDB_Reader::Load(is, encoding);
+		},
+		[](std::ostream& os, const lcf::rpg::Database& db) {
+			return lcf::LDB_Reader::Save(os, db, snapshot_encoding);
+		});
+}
+
+std::unique_ptr<lcf::rpg::TreeMap> LcfSnapshot::LoadTreeMap(StringView name, std::istream& is, StringView encoding) {
+	return Load<lcf::rpg::TreeMap>(OpenSnapshot(name), is, encoding, true,
+		[](std::istream& is, StringView encoding) {
+			return lcf::LMT_Reader::Load(is, encoding);
+		},
+		[](std::ostream& os, const lcf::rpg::TreeMap& treemap) {
+			return lcf::LMT_Reader::Save(os, treemap, snapshot_engine, snapshot_encoding);
+		});
+}
+
+std::unique_ptr<lcf::rpg::Map> LcfSnapshot::LoadMap(StringView name, std::istream& is, StringView encoding) {
+	return LoadMapSnapshot(OpenSnapshot(name), is, encoding, true);
+}
+
+LcfSnapshot::Snapshot LcfSnapshot::OpenSnapshot(StringView name) {
+	Snapshot snapshot;
+	if (!cache_directory.empty()) {
+		snapshot.path = GetSnapshotPath(name);
+		snapshot.is = FileFinder::OpenInputStream(snapshot.path, std::ios_base::in | std::ios_base::binary);
+	}
+	return snapshot;
+}
+
+std::unique_ptr<lcf::rpg::Map> LcfSnapshot::LoadMapInBackground(Snapshot snapshot, std::istream& is, StringView encoding) {
+	return LoadMapSnapshot(std::move(snapshot), is, encoding, false);
+}
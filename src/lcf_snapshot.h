@@ -0,0 +1,129 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_LCF_SNAPSHOT_H
+#define EP_LCF_SNAPSHOT_H
+
+// Headers
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include "filesystem_stream.h"
+#include "string_view.h"
+
+namespace lcf {
+namespace rpg {
+	class Database;
+	class Map;
+	class TreeMap;
+}
+}
+
+/**
+ * Cache of already parsed LDB, LMT and LMU files.
+ *
+ * Parsing the RPG Maker files includes converting every string from the
+ * game encoding to UTF-8, which is slow for big games. After parsing, the
+ * data is written to the cache directory as a snapshot with UTF-8 strings
+ * which is read back without any conversion the next time.
+ *
+ * A snapshot is only used when the CRC32 of the source file and the
+ * encoding match, otherwise the source is parsed and the snapshot replaced.
+ * All functions fall back to parsing the source when no cache directory
+ * is configured.
+ */
+namespace LcfSnapshot {
+	/**
+	 * Sets the directory the snapshots are stored in.
+	 *
+	 * @param path existing directory, empty disables the cache
+	 */
+	void SetCacheDirectory(std::string path);
+
+	/** @return the cache directory, empty when disabled */
+	const std::string& GetCacheDirectory();
+
+	/**
+	 * Snapshots are named after the source file prefixed with a hash of the
+	 * game path, games sharing the cache directory do not overwrite each
+	 * other's snapshots.
+	 *
+	 * @param name filename of the source
+	 * @return path of the snapshot of the current game
+	 */
+	std::string GetSnapshotPath(StringView name);
+
+	/**
+	 * Loads a database (LDB).
+	 *
+	 * @param name filename of the source, used as the snapshot name
+	 * @param is stream of the source, must be seekable
+	 * @param encoding encoding of the source
+	 * @return database or nullptr on parse error
+	 */
+	std::unique_ptr<lcf::rpg::Database> LoadDatabase(StringView name, std::istream& is, StringView encoding);
+
+	/**
+	 * Loads a map tree (LMT).
+	 *
+	 * @param name filename of the source, used as the snapshot name
+	 * @param is stream of the source, must be seekable
+	 * @param encoding encoding of the source
+	 * @return map tree or nullptr on parse error
+	 */
+	std::unique_ptr<lcf::rpg::TreeMap> LoadTreeMap(StringView name, std::istream& is, StringView encoding);
+
+	/**
+	 * Loads a map (LMU).
+	 *
+	 * @param name filename of the source, used as the snapshot name
+	 * @param is stream of the source, must be seekable
+	 * @param encoding encoding of the source
+	 * @return map or nullptr on parse error
+	 */
+	std::unique_ptr<lcf::rpg::Map> LoadMap(StringView name, std::istream& is, StringView encoding);
+
+	/** Snapshot opened on the main thread and loaded by a background thread */
+	struct Snapshot {
+		/** Path of the snapshot, empty when no cache directory is configured */
+		std::string path;
+		/** Stream of the snapshot, invalid when it does not exist */
+		Filesystem_Stream::InputStream is;
+	};
+
+	/**
+	 * Opens the snapshot of a file for LoadMapInBackground.
+	 * Must be called on the main thread, FileFinder is not thread-safe.
+	 *
+	 * @param name filename of the source
+	 * @return snapshot
+	 */
+	Snapshot OpenSnapshot(StringView name);
+
+	/**
+	 * Loads a map (LMU) like LoadMap on a background thread.
+	 * Nothing is logged because Output is not thread-safe.
+	 *
+	 * @param snapshot snapshot returned by OpenSnapshot
+	 * @param is stream of the source, must be seekable
+	 * @param encoding encoding of the source
+	 * @return map or nullptr on parse error
+	 */
+	std::unique_ptr<lcf::rpg::Map> LoadMapInBackground(Snapshot snapshot, std::istream& is, StringView encoding);
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_LRU_CACHE_H
+#define EP_LRU_CACHE_H
+
+// Headers
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Map which keeps track of the order in which the entries were used.
+ * Bounding the size is up to the user: Check the size after inserting and
+ * remove the least recently used entries.
+ * References to values stay valid until the entry is removed.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+	public:
+		/**
+		 * Looks up a value and marks it as most recently used.
+		 *
+		 * @param key key of the value
+		 * @return value or nullptr when not found
+		 */
+		V* Find(const K& key);
+
+		/**
+		 * Inserts or replaces a value and marks it as most recently used.
+		 *
+		 * @param key key of the value
+		 * @param value value to insert
+		 * @return the inserted value
+		 */
+		V& Insert(K key, V value);
+
+		/** @return amount of entries */
+		size_t Size() const;
+
+		/** @return least recently used value, the cache must not be empty */
+		V& Oldest();
+
+		/** Removes the least recently used entry, the cache must not be empty */
+		void RemoveOldest();
+
+		/** Removes all entries */
+		void Clear();
+
+	private:
+		using list_type = std::list<std::pair<K, V>>;
+
+		/** Most recently used first */
+		list_type lru;
+		std::unordered_map<K, typename list_type::iterator, Hash> lookup;
+};
+
+/**
+ * Hash function for std::tuple keys, combines the std::hash of all elements.
+ */
+struct TupleHash {
+	template <typename... Args>
+	size_t operator()(const std::tuple<Args...>& t) const {
+		return Combine(t, std::index_sequence_for<Args...>());
+	}
+
+	private:
+		template <typename T, size_t... I>
+		static size_t Combine(const T& t, std::index_sequence<I...>) {
+			size_t h = 0;
+			using expand = int[];
+			(void)expand{ 0, ((h ^= std::hash<std::decay_t<std::tuple_element_t<I, T>>>()(std::get<I>(t)) + 0x9e3779b9 + (h << 6) + (h >> 2)), 0)... };
+			return h;
+		}
+};
+
+template <typename K, typename V, typename Hash>
+inline V* LruCache<K, V, Hash>::Find(const K& key) {
+	auto it = lookup.find(key);
+	if (it == lookup.end()) {
+		return nullptr;
+	}
+	lru.splice(lru.begin(), lru, it->second);
+	return &it->second->second;
+}
+
+template <typename K, typename V, typename Hash>
+inline V& LruCache<K, V, Hash>::Insert(K key, V value) {
+	auto it = lookup.find(key);
+	if (it != lookup.end()) {
+		lru.erase(it->second);
+		lookup.erase(it);
+	}
+
+	lru.emplace_front(std::move(key), std::move(value));
+	lookup.emplace(lru.front().first, lru.begin());
+	return lru.front().second;
+}
+
+template <typename K, typename V, typename Hash>
+inline size_t LruCache<K, V, Hash>::Size() const {
+	return lru.size();
+}
+
+template <typename K, typename V, typename Hash>
+inline V& LruCache<K, V, Hash>::Oldest() {
+	assert(!lru.empty());
+	return lru.back().second;
+}
+
+template <typename K, typename V, typename Hash>
+inline void LruCache<K, V, Hash>::RemoveOldest() {
+	assert(!lru.empty());
+	lookup.erase(lru.back().first);
+	lru.pop_back();
+}
+
+template <typename K, typename V, typename Hash>
+inline void LruCache<K, V, Hash>::Clear() {
+	lookup.clear();
+	lru.clear();
+}
+
+#endif
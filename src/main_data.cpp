@@ -33,6 +33,8 @@
 #include "game_targets.h"
 #include "game_quit.h"
 #include "font.h"
+#include "output.h"
+#include "platform.h"
 #include "player.h"
 #include "system.h"
 
@@ -57,6 +59,8 @@
 // Global variables.
 std::string project_path;
 std::string save_path;
+/** Save directory of the project when it is a packed game archive */
+std::string archive_save_path;
 
 namespace Main_Data {
 	// Dynamic Game lcf::Data
@@ -182,10 +186,26 @@ const std::string& Main_Data::GetProjectPath() {
 
 void Main_Data::SetProjectPath(const std::string& path) {
 	project_path = path;
+
+	// Savegames of packed games cannot be written into the archive.
+	// They are stored in a directory named after the archive, so archives
+	// in the same directory do not overwrite each other's savegames.
+	archive_save_path.clear();
+	if (!path.empty() && Platform::File(path).IsFile(true)) {
+		std::string dir = path + ".saves";
+		if (Platform::File(dir).MakeDirectory()) {
+			archive_save_path = std::move(dir);
+		} else {
+			Output::Warning("Cannot create save directory {}", dir);
+		}
+	}
 }
 
 const std::string& Main_Data::GetSavePath() {
 	if (save_path.empty()) {
+		if (!archive_save_path.empty()) {
+			return archive_save_path;
+		}
 		return GetProjectPath();
 	}
 
@@ -0,0 +1,255 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "map_cache.h"
+#include "lcf_lock.h"
+#include "lcf_snapshot.h"
+#include "system.h"
+#include <lcf/lmu/reader.h>
+#include <lcf/rpg/map.h>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <mutex>
+
+#ifdef SUPPORT_THREADS
+#  include <condition_variable>
+#  include <deque>
+#  include <thread>
+#endif
+
+namespace {
+	// Upper limit of the estimated memory used by the cached maps
+	constexpr size_t cache_budget = 32 * 1024 * 1024;
+
+	struct CacheEntry {
+		int map_id;
+		std::shared_ptr<const lcf::rpg::Map> map;
+		size_t size;
+	};
+
+	std::mutex mutex;
+
+	/** Most recently used first */
+	std::list<CacheEntry> entries;
+	size_t entries_size = 0;
+
+	size_t EstimateSize(const lcf::rpg::Map& map) {
+		size_t size = sizeof(map);
+		size += map.lower_layer.size() * sizeof(decltype(map.lower_layer)::value_type);
+		size += map.upper_layer.size() * sizeof(decltype(map.upper_layer)::value_type);
+		for (const auto& ev: map.events) {
+			size += sizeof(ev);
+			for (const auto& page: ev.pages) {
+				size += sizeof(page);
+				for (const auto& cmd: page.event_commands) {
+					size += sizeof(cmd) + cmd.string.size() + cmd.parameters.size() * sizeof(int32_t);
+				}
+			}
+		}
+		return size;
+	}
+
+	std::list<CacheEntry>::iterator FindLocked(int map_id) {
+		return std::find_if(entries.begin(), entries.end(), [&](const auto& e) { return e.map_id == map_id; });
+	}
+
+	/**
+	 * @param preloaded Preloaded maps are added as least recently used, they
+	 *   are evicted before the maps which were actually visited.
+	 */
+	void AddLocked(int map_id, std::shared_ptr<const lcf::rpg::Map> map, bool preloaded) {
+		auto it = FindLocked(map_id);
+		if (it != entries.end()) {
+			entries_size -= it->size;
+			entries.erase(it);
+		}
+
+		size_t size = EstimateSize(*map);
+		if (preloaded) {
+			entries.push_back({ map_id, std::move(map), size });
+		} else {
+			entries.push_front({ map_id, std::move(map), size });
+		}
+		entries_size += size;
+
+		// A single map is always kept, even when it exceeds the budget alone
+		while (entries_size > cache_budget && entries.size() > 1) {
+			entries_size -= entries.back().size;
+			entries.pop_back();
+		}
+	}
+
+#ifdef SUPPORT_THREADS
+	struct PreloadJob {
+		int map_id;
+		Filesystem_Stream::InputStream is;
+		LcfSnapshot::Snapshot snapshot;
+		std::string encoding;
+		bool is_xml;
+	};
+
+	std::condition_variable cv;
+	std::deque<PreloadJob> jobs;
+	/** Map currently parsed by the worker, 0 when idle */
+	int running_id = 0;
+	bool quit = false;
+
+	void WorkerMain() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			cv.wait(lock, [] { return quit || !jobs.empty(); });
+			if (quit) {
+				return;
+			}
+
+			PreloadJob job = std::move(jobs.front());
+			jobs.pop_front();
+			running_id = job.map_id;
+			lock.unlock();
+
+			std::unique_ptr<lcf::rpg::Map> map;
+			{
+				auto lcf_lock = LcfLock::Acquire();
+				map = job.is_xml
+					? lcf::LMU_Reader::LoadXml(job.is)
+					: LcfSnapshot::LoadMapInBackground(std::move(job.snapshot), job.is, job.encoding);
+			}
+
+			lock.lock();
+			running_id = 0;
+			// Parse errors are reported when the map is loaded regularly
+			if (map) {
+				AddLocked(job.map_id, std::move(map), true);
+			}
+			cv.notify_all();
+		}
+	}
+
+	bool IsQueuedLocked(int map_id) {
+		return running_id == map_id || std::any_of(jobs.begin(), jobs.end(), [&](const auto& job) { return job.map_id == map_id; });
+	}
+
+	/**
+	 * Owns the worker thread and stops it on destruction.
+	 * Destroying a joinable std::thread terminates the program, this happens
+	 * when exit() is called while the worker runs, e.g. by Output::Error.
+	 */
+	struct Worker {
+		std::thread thread;
+
+		~Worker() {
+			Stop();
+		}
+
+		void Start() {
+			if (!thread.joinable()) {
+				thread = std::thread(WorkerMain);
+			}
+		}
+
+		void Stop() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+				jobs.clear();
+				cv.notify_all();
+			}
+			if (thread.joinable()) {
+				thread.join();
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = false;
+		}
+	};
+
+	Worker& GetWorker() {
+		// Constructed on first use, so it is destroyed before the other globals
+		static Worker worker;
+		return worker;
+	}
+#endif
+}
+
+std::shared_ptr<const lcf::rpg::Map> MapCache::Get(int map_id) {
+	std::unique_lock<std::mutex> lock(mutex);
+
+#ifdef SUPPORT_THREADS
+	cv.wait(lock, [&] { return running_id != map_id; });
+
+	// Not started yet, loading it directly is faster than waiting for the queue
+	jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [&](const auto& job) { return job.map_id == map_id; }), jobs.end());
+#endif
+
+	auto it = FindLocked(map_id);
+	if (it == entries.end()) {
+		return nullptr;
+	}
+	entries.splice(entries.begin(), entries, it);
+	return it->map;
+}
+
+void MapCache::Add(int map_id, std::shared_ptr<const lcf::rpg::Map> map) {
+	std::lock_guard<std::mutex> lock(mutex);
+	AddLocked(map_id, std::move(map), false);
+}
+
+void MapCache::Preload(int map_id, StringView map_name, Filesystem_Stream::InputStream is, std::string encoding, bool is_xml) {
+#ifdef SUPPORT_THREADS
+	std::lock_guard<std::mutex> lock(mutex);
+	if (FindLocked(map_id) != entries.end() || IsQueuedLocked(map_id)) {
+		return;
+	}
+
+	// Opened here because FileFinder is not thread-safe, EasyRPG XML maps have no snapshots
+	LcfSnapshot::Snapshot snapshot;
+	if (!is_xml) {
+		snapshot = LcfSnapshot::OpenSnapshot(map_name);
+	}
+
+	jobs.push_back({ map_id, std::move(is), std::move(snapshot), std::move(encoding), is_xml });
+	GetWorker().Start();
+	cv.notify_all();
+#else
+	(void)map_id;
+	(void)map_name;
+	(void)is;
+	(void)encoding;
+	(void)is_xml;
+#endif
+}
+
+bool MapCache::Contains(int map_id) {
+	std::lock_guard<std::mutex> lock(mutex);
+#ifdef SUPPORT_THREADS
+	if (IsQueuedLocked(map_id)) {
+		return true;
+	}
+#endif
+	return FindLocked(map_id) != entries.end();
+}
+
+void MapCache::Clear() {
+#ifdef SUPPORT_THREADS
+	GetWorker().Stop();
+#endif
+
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	entries_size = 0;
+}
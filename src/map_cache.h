@@ -0,0 +1,81 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_MAP_CACHE_H
+#define EP_MAP_CACHE_H
+
+// Headers
+#include <memory>
+#include <string>
+#include "filesystem_stream.h"
+#include "string_view.h"
+
+namespace lcf {
+namespace rpg {
+	class Map;
+}
+}
+
+/**
+ * LRU cache of parsed maps with a memory budget.
+ *
+ * Maps which are likely visited next can be preloaded: They are parsed by
+ * a background thread, using the LcfSnapshot when available, and added to
+ * the cache as least recently used. On platforms without thread support
+ * preloading does nothing.
+ *
+ * The cached maps are never modified, users must copy them.
+ */
+namespace MapCache {
+	/**
+	 * Looks up a map. Waits when the map is currently parsed by the
+	 * background thread.
+	 *
+	 * @param map_id ID of the map
+	 * @return map or nullptr when not cached
+	 */
+	std::shared_ptr<const lcf::rpg::Map> Get(int map_id);
+
+	/**
+	 * Adds a map to the cache. Least recently used maps are removed when
+	 * the cache exceeds the budget.
+	 *
+	 * @param map_id ID of the map
+	 * @param map parsed map
+	 */
+	void Add(int map_id, std::shared_ptr<const lcf::rpg::Map> map);
+
+	/**
+	 * Queues a map for parsing by the background thread.
+	 * Maps which are already cached or queued are ignored.
+	 *
+	 * @param map_id ID of the map
+	 * @param map_name filename of the map, used as the snapshot name
+	 * @param is stream of the map file, opened by the caller because FileFinder is not thread-safe
+	 * @param encoding encoding of the map file
+	 * @param is_xml whether the map is an EasyRPG XML map
+	 */
+	void Preload(int map_id, StringView map_name, Filesystem_Stream::InputStream is, std::string encoding, bool is_xml);
+
+	/** @return whether the map is cached or queued for preloading */
+	bool Contains(int map_id);
+
+	/** Cancels all preloads, stops the background thread and clears the cache */
+	void Clear();
+}
+
+#endif
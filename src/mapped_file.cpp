@@ -0,0 +1,104 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+#  include "utils.h"
+#  define EP_HAVE_MMAP
+#elif defined(__unix__) || defined(__APPLE__)
+#  include <unistd.h>
+#  if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    define EP_HAVE_MMAP
+#  endif
+#endif
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::string& path) {
+#if defined(EP_HAVE_MMAP) && defined(_WIN32)
+	HANDLE file = CreateFileW(Utils::ToWideString(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) {
+		return nullptr;
+	}
+
+	// The view keeps the mapping alive
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view) {
+		return nullptr;
+	}
+
+	std::shared_ptr<MappedFile> mf(new MappedFile());
+	mf->map_data = static_cast<const uint8_t*>(view);
+	mf->map_size = static_cast<size_t>(file_size.QuadPart);
+	return mf;
+#elif defined(EP_HAVE_MMAP)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid after closing the descriptor
+	void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	std::shared_ptr<MappedFile> mf(new MappedFile());
+	mf->map_data = static_cast<const uint8_t*>(addr);
+	mf->map_size = static_cast<size_t>(st.st_size);
+	return mf;
+#else
+	(void)path;
+	return nullptr;
+#endif
+}
+
+MappedFile::~MappedFile() {
+	if (!map_data) {
+		return;
+	}
+#if defined(EP_HAVE_MMAP) && defined(_WIN32)
+	UnmapViewOfFile(map_data);
+#elif defined(EP_HAVE_MMAP)
+	munmap(const_cast<uint8_t*>(map_data), map_size);
+#endif
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_MAPPED_FILE_H
+#define EP_MAPPED_FILE_H
+
+// Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file.
+ * Only available on platforms which support mmap (or the Windows
+ * equivalent), otherwise Open always fails and the caller must fall back
+ * to a buffered stream.
+ */
+class MappedFile {
+public:
+	/**
+	 * Maps the file into memory.
+	 *
+	 * @param path Path to the file
+	 * @return the mapping or nullptr when mapping is not supported or failed
+	 */
+	static std::shared_ptr<MappedFile> Open(const std::string& path);
+
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/** @return pointer to the file contents */
+	const uint8_t* data() const;
+
+	/** @return size of the file in bytes */
+	size_t size() const;
+
+private:
+	MappedFile() = default;
+
+	const uint8_t* map_data = nullptr;
+	size_t map_size = 0;
+};
+
+inline const uint8_t* MappedFile::data() const {
+	return map_data;
+}
+
+inline size_t MappedFile::size() const {
+	return map_size;
+}
+
+#endif
@@ -23,9 +23,11 @@
 #include <memory>
 #include <sstream>
 #include <lcf/data.h>
+#include "file_hash.h"
 #include "filefinder.h"
 #include <lcf/lmt/reader.h>
 #include <lcf/lsd/reader.h>
+#include "lcf_lock.h"
 #include "main_data.h"
 #include "meta.h"
 #include "output.h"
@@ -54,14 +56,11 @@
 
 // Helper: Get the CRC32 of a given file as a hex string
 std::string crc32file(std::string file_name) {
-	if (!file_name.empty()) {
-		auto in = FileFinder::OpenInputStream(file_name);
-		if (in) {
-			auto crc = Utils::CRC32(in);
-			std::stringstream res;
-			res <<std::hex << std::setfill('0') <<std::setw(8) <<crc;
-			return res.str();
-		}
+	uint32_t crc;
+	if (!file_name.empty() && FileHash::GetCRC32(file_name, crc)) {
+		std::stringstream res;
+		res <<std::hex << std::setfill('0') <<std::setw(8) <<crc;
+		return res.str();
 	}
 	return "";
 }
@@ -177,7 +176,11 @@ std::vector<Meta::FileItem> Meta::BuildImportCandidateList(const DirectoryTreeVi
 			// Note that corruptness is checked later (in window_savefile.cpp)
 			std::string file = child_tree->FindFile(ss.str());
 			if (!file.empty()) {
-				std::unique_ptr<lcf::rpg::Save> savegame = lcf::LSD_Reader::Load(file, Player::encoding);
+				std::unique_ptr<lcf::rpg::Save> savegame;
+				{
+					auto lcf_lock = LcfLock::Acquire();
+					savegame = lcf::LSD_Reader::Load(file, Player::encoding);
+				}
 				if (savegame != nullptr) {
 					if (savegame->party_location.map_id == pivot_map_id || pivot_map_id==0) {
 						FileItem item;
@@ -64,6 +64,7 @@ namespace midisequencer{
     {
         messages.clear();
         long_messages.clear();
+        tempo_map.clear();
         position = messages.begin();
     }
     void sequencer::rewind()
@@ -422,11 +423,17 @@ namespace midisequencer{
             }
         }
         std::stable_sort(messages.begin(), messages.end());
-        if(!(division & 0x8000)){
+        if(division & 0x8000){
+            // Upper byte is the negative SMPTE frame rate
+            int fps = 256 - ((division >> 8) & 0xFF);
+            int frames = division & 0xFF;
+            tempo_map.push_back(tempo_point{0.0f, 0, static_cast<double>(fps * frames)});
+        }else{
             uint_least32_t tempo = 500000;
             double time_offset = 0;
             double base = 0;
             loop_position = messages.begin();
+            tempo_map.push_back(tempo_point{0.0f, 0, division * 1000000.0 / tempo});
             for(std::vector<midi_message>::iterator i = messages.begin(); i != messages.end(); ++i){
                 float org_time = i->time;
                 i->time = (i->time - base) * tempo / 1000000.0 / division + time_offset;
@@ -439,6 +446,7 @@ namespace midisequencer{
                               | static_cast<unsigned char>(s[3]);
                         base = org_time;
                         time_offset = i->time;
+                        tempo_map.push_back(tempo_point{i->time, static_cast<int>(org_time), division * 1000000.0 / tempo});
                     }
                 }
                 // If the message matches the de facto standard MIDI loop instruction:
@@ -457,4 +465,18 @@ namespace midisequencer{
 	uint32_t sequencer::get_division() const {
 		return division;
 	}
+
+    // Converts a playback time (seconds) to MIDI ticks.
+    int sequencer::get_ticks(float time)const
+    {
+        if(tempo_map.empty()){
+            return 0;
+        }
+        std::vector<tempo_point>::const_iterator i = std::upper_bound(tempo_map.begin(), tempo_map.end(), time,
+            [](float t, const tempo_point& p){ return t < p.time; });
+        if(i != tempo_map.begin()){
+            --i;
+        }
+        return i->ticks + static_cast<int>(i->ticks_per_sec * (time - i->time));
+    }
 }
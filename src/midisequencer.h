@@ -78,10 +78,18 @@ namespace midisequencer{
         std::string get_copyright()const;
         std::string get_song()const;
         uint32_t get_division()const;
+        int get_ticks(float time)const;
         void play(float time, output* out);
         void set_time(float time, output* out);
     private:
+        // Tempo change. Maps between time in seconds and MIDI ticks.
+        struct tempo_point{
+            float time;
+            int ticks;
+            double ticks_per_sec;
+        };
         std::vector<midi_message> messages;
+        std::vector<tempo_point> tempo_map;
         std::vector<midi_message>::iterator position;
         std::vector<midi_message>::iterator loop_position;
         std::vector<std::string> long_messages;
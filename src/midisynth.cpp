@@ -695,6 +695,36 @@ namespace midisynth{
         uint_least32_t p = ((position += step) / 32768 + m) % sine_table::DIVISION;
         return sine_table.get(p);
     }
+    // Advances the phase like get_block without producing samples.
+    void sine_wave_generator::skip(const int_least32_t* vibrato, std::size_t samples)
+    {
+        if(vibrato){
+            for(std::size_t i = 0; i < samples; ++i){
+                add_modulation(vibrato[i]);
+            }
+        }
+        position += static_cast<uint_least32_t>(samples * step);
+    }
+    // Gets the next block of samples.
+    // modulation and vibrato are optional per-sample inputs (nullptr when unused).
+    void sine_wave_generator::get_block(int_least32_t* out, const int_least32_t* modulation, const int_least32_t* vibrato, std::size_t samples)
+    {
+        if(vibrato){
+            for(std::size_t i = 0; i < samples; ++i){
+                add_modulation(vibrato[i]);
+                out[i] = modulation ? get_next(modulation[i]) : get_next();
+            }
+        }else{
+            // Without vibrato the phase advances linearly, which keeps the
+            // iterations independent of each other.
+            uint_least32_t base = position;
+            for(std::size_t i = 0; i < samples; ++i){
+                uint_least32_t m = modulation ? modulation[i] * sine_table::DIVISION / 65536 : 0;
+                out[i] = sine_table.get((static_cast<uint_least32_t>(base + (i + 1) * step) / 32768 + m) % sine_table::DIVISION);
+            }
+            position = base + samples * step;
+        }
+    }
 
     // Logarithmic conversion table. Use in the subsequent decay of the envelope generator.
     namespace{
@@ -942,6 +972,74 @@ namespace midisynth{
             return 0;
         }
     }
+    // Gets the next block of samples.
+    // Runs a tight loop while the state does not change and hands the
+    // transitioning sample to get_next, so the output equals calling
+    // get_next once per sample.
+    void envelope_generator::get_block(int_least32_t* out, std::size_t samples)
+    {
+        std::size_t i = 0;
+        while(i < samples){
+            uint_least32_t current = this->current;
+            switch(state){
+            case ATTACK:
+            case ATTACK_RELEASE:
+                while(i < samples && current < fTL){
+                    out[i++] = current += fAR;
+                }
+                break;
+            case DECAY:
+                while(i < samples && current > fSS){
+                    current -= fDR;
+                    out[i++] = log_table.get(current / 65536);
+                }
+                break;
+            case DECAY_RELEASE:
+                while(i < samples && current > fDSS){
+                    current -= fDRR;
+                    out[i++] = log_table.get(current / 65536);
+                }
+                break;
+            case SASTAIN:
+                while(i < samples && current > fSR){
+                    int n = log_table.get((current - fSR) / 65536);
+                    if(n <= 1){
+                        break;
+                    }
+                    current -= fSR;
+                    out[i++] = n;
+                }
+                break;
+            case RELEASE:
+                while(i < samples && current > fRR){
+                    int n = log_table.get((current - fRR) / 65536);
+                    if(n <= SOUNDOFF_LEVEL){
+                        break;
+                    }
+                    current -= fRR;
+                    out[i++] = n;
+                }
+                break;
+            case SOUNDOFF:
+                while(i < samples && current > fOR){
+                    int n = log_table.get((current - fOR) / 65536);
+                    if(n <= 1){
+                        break;
+                    }
+                    current -= fOR;
+                    out[i++] = n;
+                }
+                break;
+            case FINISHED:
+                std::fill(out + i, out + samples, 0);
+                return;
+            }
+            this->current = current;
+            if(i < samples){
+                out[i++] = get_next();
+            }
+        }
+    }
 
     namespace{
         // Key scaling table
@@ -1104,6 +1202,49 @@ namespace midisynth{
     {
         return (static_cast<int_least32_t>(swg.get_next(modulate)) * eg.get_next() >> 15) * (ams * ams_factor + ams_bias) >> 15;
     }
+    // Gets the next block of samples (at most fm_sound_generator::BLOCK_SIZE).
+    // ams, modulate and vibrato are optional per-sample inputs (nullptr when unused).
+    void fm_operator::get_block(int_least32_t* out, const int_least32_t* ams, const int_least32_t* modulate, const int_least32_t* vibrato, std::size_t samples)
+    {
+        assert(samples <= fm_sound_generator::BLOCK_SIZE);
+        if(eg.is_finished()){
+            // Silent, only the phase must advance
+            swg.skip(vibrato, samples);
+            std::fill(out, out + samples, 0);
+            return;
+        }
+        int_least32_t env[fm_sound_generator::BLOCK_SIZE];
+        eg.get_block(env, samples);
+        swg.get_block(out, modulate, vibrato, samples);
+        if(ams){
+            for(std::size_t i = 0; i < samples; ++i){
+                out[i] = (out[i] * env[i] >> 15) * (ams[i] * ams_factor + ams_bias) >> 15;
+            }
+        }else{
+            for(std::size_t i = 0; i < samples; ++i){
+                out[i] = out[i] * env[i] >> 15;
+            }
+        }
+    }
+    // Gets the next block of samples for an operator modulated by its own output.
+    // Returns the last sample which is the feedback for the next block.
+    int fm_operator::get_block_feedback(int_least32_t* out, const int_least32_t* ams, int feedback, int FB, const int_least32_t* vibrato, std::size_t samples)
+    {
+        assert(samples <= fm_sound_generator::BLOCK_SIZE);
+        int_least32_t env[fm_sound_generator::BLOCK_SIZE];
+        eg.get_block(env, samples);
+        for(std::size_t i = 0; i < samples; ++i){
+            if(vibrato){
+                swg.add_modulation(vibrato[i]);
+            }
+            int x = static_cast<int_least32_t>(swg.get_next((feedback << 1) >> FB)) * env[i] >> 15;
+            if(ams){
+                x = x * (ams[i] * ams_factor + ams_bias) >> 15;
+            }
+            out[i] = feedback = x;
+        }
+        return feedback;
+    }
 
     // Vibrato table.
     namespace{
@@ -1346,6 +1487,111 @@ namespace midisynth{
         }
         return ret;
     }
+    // Gets the next block of samples (at most BLOCK_SIZE).
+    // The LFOs and envelopes do not depend on the signal and every algorithm
+    // is a chain where only op1 feeds back into itself, so each operator is
+    // rendered for the whole block before the next one.
+    // The output is identical to calling get_next once per sample.
+    void fm_sound_generator::get_block(int_least32_t* out, std::size_t samples)
+    {
+        assert(samples <= BLOCK_SIZE);
+        int_least32_t vibrato_buf[BLOCK_SIZE];
+        int_least32_t ams_buf[BLOCK_SIZE];
+        int_least32_t b1[BLOCK_SIZE];
+        int_least32_t b2[BLOCK_SIZE];
+        int_least32_t b3[BLOCK_SIZE];
+        const int_least32_t* vibrato = nullptr;
+        const int_least32_t* ams = nullptr;
+
+        if(vibrato_depth){
+            for(std::size_t i = 0; i < samples; ++i){
+                int x = static_cast<int_least32_t>(vibrato_lfo.get_next()) * vibrato_depth >> 15;
+                vibrato_buf[i] = vibrato_table.get(x);
+            }
+            vibrato = vibrato_buf;
+        }
+        if(ams_enable){
+            for(std::size_t i = 0; i < samples; ++i){
+                ams_buf[i] = ams_lfo.get_next() >> 7;
+            }
+            ams = ams_buf;
+        }
+
+        feedback = op1.get_block_feedback(b1, ams, feedback, FB, vibrato, samples);
+        switch(ALG){
+        case 0:
+            op2.get_block(b2, ams, b1, vibrato, samples);
+            op3.get_block(b3, ams, b2, vibrato, samples);
+            op4.get_block(out, ams, b3, vibrato, samples);
+            break;
+        case 1:
+            op2.get_block(b2, ams, nullptr, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                b2[i] += b1[i];
+            }
+            op3.get_block(b3, ams, b2, vibrato, samples);
+            op4.get_block(out, ams, b3, vibrato, samples);
+            break;
+        case 2:
+            op2.get_block(b2, ams, nullptr, vibrato, samples);
+            op3.get_block(b3, ams, b2, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                b3[i] += b1[i];
+            }
+            op4.get_block(out, ams, b3, vibrato, samples);
+            break;
+        case 3:
+            op2.get_block(b2, ams, b1, vibrato, samples);
+            op3.get_block(b3, ams, nullptr, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                b3[i] += b2[i];
+            }
+            op4.get_block(out, ams, b3, vibrato, samples);
+            break;
+        case 4:
+            op2.get_block(b2, ams, b1, vibrato, samples);
+            op3.get_block(b3, ams, nullptr, vibrato, samples);
+            op4.get_block(out, ams, b3, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                out[i] += b2[i];
+            }
+            break;
+        case 5:
+            op2.get_block(b2, ams, b1, vibrato, samples);
+            op3.get_block(b3, ams, b1, vibrato, samples);
+            op4.get_block(out, ams, b1, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                out[i] += b3[i] + b2[i];
+            }
+            break;
+        case 6:
+            op2.get_block(b2, ams, b1, vibrato, samples);
+            op3.get_block(b3, ams, nullptr, vibrato, samples);
+            op4.get_block(out, ams, nullptr, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                out[i] += b3[i] + b2[i];
+            }
+            break;
+        case 7:
+            op2.get_block(b2, ams, nullptr, vibrato, samples);
+            op3.get_block(b3, ams, nullptr, vibrato, samples);
+            op4.get_block(out, ams, nullptr, vibrato, samples);
+            for(std::size_t i = 0; i < samples; ++i){
+                out[i] += b3[i] + b2[i] + b1[i];
+            }
+            break;
+        default:
+            assert(!"fm_sound_generator: invalid algorithm number");
+            std::fill(out, out + samples, 0);
+            return;
+        }
+        if(tremolo_depth){
+            for(std::size_t i = 0; i < samples; ++i){
+                int_least32_t x = 4096 - (((static_cast<int_least32_t>(tremolo_lfo.get_next()) + 32768) * tremolo_depth) >> 11);
+                out[i] = out[i] * x >> 12;
+            }
+        }
+    }
 
     // FM notes constructor.
     fm_note::fm_note(const FMPARAMETER& params, int note, int velocity_, int panpot, int assign, float frequency_multiplier):
@@ -1362,10 +1608,19 @@ namespace midisynth{
         left = (left * velocity) >> 7;
         right = (right * velocity) >> 7;
         fm.set_rate(rate);
-        for(std::size_t i = 0; i < samples; ++i){
-            int_least32_t sample = fm.get_next();
-            buf[i * 2 + 0] += (sample * left) >> 14;
-            buf[i * 2 + 1] += (sample * right) >> 14;
+        int_least32_t block[fm_sound_generator::BLOCK_SIZE];
+        for(std::size_t pos = 0; pos < samples; pos += fm_sound_generator::BLOCK_SIZE){
+            // A finished note only contributes silence
+            if(fm.is_finished()){
+                break;
+            }
+            std::size_t n = std::min<std::size_t>(samples - pos, fm_sound_generator::BLOCK_SIZE);
+            fm.get_block(block, n);
+            int_least32_t* out = buf + pos * 2;
+            for(std::size_t i = 0; i < n; ++i){
+                out[i * 2 + 0] += (block[i] * left) >> 14;
+                out[i * 2 + 1] += (block[i] * right) >> 14;
+            }
         }
         return !fm.is_finished();
     }
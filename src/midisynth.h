@@ -262,6 +262,8 @@ namespace midisynth{
         void add_modulation(int_least32_t x);
         int get_next();
         int get_next(int_least32_t modulation);
+        void get_block(int_least32_t* out, const int_least32_t* modulation, const int_least32_t* vibrato, std::size_t samples);
+        void skip(const int_least32_t* vibrato, std::size_t samples);
     private:
         uint_least32_t position;
         uint_least32_t step;
@@ -279,6 +281,7 @@ namespace midisynth{
         void sound_off();
         bool is_finished()const{ return state == FINISHED; }
         int get_next();
+        void get_block(int_least32_t* out, std::size_t samples);
     private:
         enum{ ATTACK, ATTACK_RELEASE, DECAY, DECAY_RELEASE, SASTAIN, RELEASE, SOUNDOFF, FINISHED }state;
         int AR, DR, SR, RR, TL;
@@ -307,6 +310,8 @@ namespace midisynth{
         inline int operator()(){ return get_next(); }
         inline int operator()(int m){ return get_next(m); }
         inline int operator()(int lfo, int m){ return get_next(lfo, m); }
+        void get_block(int_least32_t* out, const int_least32_t* ams, const int_least32_t* modulate, const int_least32_t* vibrato, std::size_t samples);
+        int get_block_feedback(int_least32_t* out, const int_least32_t* ams, int feedback, int FB, const int_least32_t* vibrato, std::size_t samples);
     private:
         sine_wave_generator swg;
         envelope_generator eg;
@@ -343,6 +348,9 @@ namespace midisynth{
         void sound_off();
         bool is_finished()const;
         int get_next();
+        void get_block(int_least32_t* out, std::size_t samples);
+        // Number of samples rendered per operator in one block.
+        enum{ BLOCK_SIZE = 64 };
     private:
         fm_operator op1;
         fm_operator op2;
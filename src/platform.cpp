@@ -19,8 +19,16 @@
 #include "platform.h"
 #include "utils.h"
 #include <cassert>
+#include <cstdio>
 #include <utility>
 
+#ifdef PSP2
+#  include <psp2/io/fcntl.h>
+#elif !defined(_WIN32)
+#  include <cerrno>
+#  include <fcntl.h>
+#endif
+
 #ifndef DT_UNKNOWN
 #define DT_UNKNOWN 0
 #endif
@@ -124,6 +132,91 @@ int64_t Platform::File::GetSize() const {
 #endif
 }
 
+int64_t Platform::File::GetModificationTime() const {
+#if defined(_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	BOOL res = ::GetFileAttributesExW(filename.c_str(),
+			GetFileExInfoStandard,
+			&data);
+	if (!res) {
+		return -1;
+	}
+
+	return ((int64_t)data.ftLastWriteTime.dwHighDateTime << 32) | (int64_t)data.ftLastWriteTime.dwLowDateTime;
+#elif defined(PSP2)
+	return -1;
+#else
+	struct stat sb = {};
+	int result = ::stat(filename.c_str(), &sb);
+	if (result != 0) {
+		return -1;
+	}
+
+	// Seconds are too coarse, a change in the same second as a scan would go unnoticed
+#  if defined(__APPLE__)
+	return (int64_t)sb.st_mtimespec.tv_sec * 1000000000 + sb.st_mtimespec.tv_nsec;
+#  elif defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__HAIKU__)
+	return (int64_t)sb.st_mtim.tv_sec * 1000000000 + sb.st_mtim.tv_nsec;
+#  else
+	return (int64_t)sb.st_mtime;
+#  endif
+#endif
+}
+
+bool Platform::File::Rename(const std::string& target) const {
+#if defined(_WIN32)
+	return ::MoveFileExW(filename.c_str(), Utils::ToWideString(target).c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#elif defined(PSP2)
+	// Does not replace existing files
+	::sceIoRemove(target.c_str());
+	return ::sceIoRename(filename.c_str(), target.c_str()) >= 0;
+#else
+#  if (defined(GEKKO) || defined(_3DS) || defined(__SWITCH__))
+	// Does not replace existing files
+	::remove(target.c_str());
+#  endif
+	return ::rename(filename.c_str(), target.c_str()) == 0;
+#endif
+}
+
+bool Platform::File::Sync() const {
+#if defined(_WIN32)
+	// FlushFileBuffers requires write access
+	HANDLE handle = ::CreateFileW(filename.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	bool res = ::FlushFileBuffers(handle) != 0;
+	::CloseHandle(handle);
+	return res;
+#elif defined(PSP2) || defined(GEKKO) || defined(_3DS) || defined(__SWITCH__) || defined(EMSCRIPTEN)
+	// No fsync, the data is written when the file is closed
+	return Exists();
+#else
+	// fsync flushes the data of the file, not only of this descriptor
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	bool res = ::fsync(fd) == 0 || errno == EINVAL || errno == ENOTSUP;
+	::close(fd);
+	return res;
+#endif
+}
+
+bool Platform::File::MakeDirectory() const {
+#if defined(_WIN32)
+	bool res = ::CreateDirectoryW(filename.c_str(), nullptr) != 0;
+#elif defined(PSP2)
+	bool res = ::sceIoMkdir(filename.c_str(), 0777) >= 0;
+#else
+	bool res = ::mkdir(filename.c_str(), 0777) == 0;
+#endif
+	return res || IsDirectory(true);
+}
+
 Platform::Directory::Directory(const std::string& name) {
 #if defined(_WIN32)
 	dir_handle = ::_wopendir(Utils::ToWideString(name).c_str());
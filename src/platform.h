@@ -94,6 +94,38 @@ namespace Platform {
 		/** @return Filesize or -1 on error */
 		int64_t GetSize() const;
 
+		/**
+		 * The resolution depends on the platform (100 ns on Windows, 1 ns on
+		 * Linux, BSD and macOS, seconds elsewhere), only use it for comparisons.
+		 *
+		 * @return Last modification time or -1 on error or when unsupported
+		 */
+		int64_t GetModificationTime() const;
+
+		/**
+		 * Renames the file, an existing file at the target is replaced.
+		 *
+		 * @param target New path of the file
+		 * @return true on success
+		 */
+		bool Rename(const std::string& target) const;
+
+		/**
+		 * Writes the data of the file which the operating system still
+		 * caches to the storage. Must be called after the file was closed.
+		 *
+		 * @return true on success or when unsupported by the platform or file system
+		 */
+		bool Sync() const;
+
+		/**
+		 * Creates a directory at the path of the file.
+		 * The parent directory must exist.
+		 *
+		 * @return true on success or when the directory already exists
+		 */
+		bool MakeDirectory() const;
+
 	private:
 #ifdef _WIN32
 		const std::wstring filename;
@@ -204,7 +204,8 @@ void CtrAudio::SE_Play(std::string const& file, int volume, int pitch) {
 	int channels;
 
 	std::vector<uint8_t> dec_buf;
-	std::vector<uint8_t>* out_buf = nullptr;
+	const uint8_t* out_data = nullptr;
+	size_t bsize = 0;
 	AudioSeRef se_ref;
 	bool use_raw_buf = false;
 
@@ -217,11 +218,13 @@ void CtrAudio::SE_Play(std::string const& file, int volume, int pitch) {
 
 	if (use_raw_buf) {
 		se_ref = cache->GetSeData();
-		out_buf = &se_ref->buffer;
+		out_data = se_ref->GetData();
+		bsize = se_ref->GetSize();
 	} else {
 		dec->SetFormat(frequency, out_format, channels);
 		dec_buf = dec->DecodeAll();
-		out_buf = &dec_buf;
+		out_data = dec_buf.data();
+		bsize = dec_buf.size();
 	}
 
 	ndspChnSetRate(ndsp_channel, frequency);
@@ -230,7 +233,6 @@ void CtrAudio::SE_Play(std::string const& file, int volume, int pitch) {
 		linearFree(se_buf[se_channel].data_pcm16);
 	}
 
-	size_t bsize = out_buf->size();
 	size_t aligned_bsize = 8192;
 	// Buffer must be correctly aligned to prevent audio glitches
 	for (; ; aligned_bsize *= 2) {
@@ -244,7 +246,7 @@ void CtrAudio::SE_Play(std::string const& file, int volume, int pitch) {
 	const int samplesize = AudioDecoder::GetSamplesizeForFormat(out_format);
 	se_buf[se_channel].nsamples = bsize / (samplesize * channels);
 
-	memcpy(se_buf[se_channel].data_pcm16, out_buf->data(), out_buf->size());
+	memcpy(se_buf[se_channel].data_pcm16, out_data, bsize);
 
 	DSP_FlushDataCache(se_buf[se_channel].data_pcm16, aligned_bsize);
 
@@ -67,6 +67,11 @@
 #include "graphics.h"
 #include <lcf/inireader.h>
 #include "input.h"
+#include "lcf_lock.h"
+#include "lcf_snapshot.h"
+#include "map_cache.h"
+#include "file_hash.h"
+#include "save_writer.h"
 #include <lcf/ldb/reader.h>
 #include <lcf/lmt/reader.h>
 #include <lcf/lsd/reader.h>
@@ -121,6 +126,8 @@ namespace Player {
 	int frames;
 	std::string replay_input_path;
 	std::string record_input_path;
+	std::string directory_index_path;
+	std::string game_list_cache_path;
 	std::string command_line;
 	int speed_modifier = 3;
 	Game_ConfigPlayer player_config;
@@ -412,6 +419,9 @@ void Player::Exit() {
 	Font::Dispose();
 	DynRpg::Reset();
 	Graphics::Quit();
+	MapCache::Clear();
+	FileHash::Clear();
+	SaveWriter::Quit();
 	FileFinder::Quit();
 	Output::Quit();
 	DisplayUi.reset();
@@ -625,6 +635,24 @@ Game_Config Player::ParseCommandLine(int argc, char *argv[]) {
 			}
 			continue;
 		}
+		if (cp.ParseNext(arg, 1, "--directory-index")) {
+			if (arg.NumValues() > 0) {
+				directory_index_path = arg.Value(0);
+			}
+			continue;
+		}
+		if (cp.ParseNext(arg, 1, "--game-list-cache")) {
+			if (arg.NumValues() > 0) {
+				game_list_cache_path = arg.Value(0);
+			}
+			continue;
+		}
+		if (cp.ParseNext(arg, 1, "--snapshot-cache")) {
+			if (arg.NumValues() > 0) {
+				LcfSnapshot::SetCacheDirectory(arg.Value(0));
+			}
+			continue;
+		}
 		if (cp.ParseNext(arg, 1, "--encoding")) {
 			if (arg.NumValues() > 0) {
 				forced_encoding = arg.Value(0);
@@ -915,6 +943,7 @@ void Player::GuessNonStandardExtensions() {
 void Player::LoadDatabase() {
 	// Load lcf::Database
 	lcf::Data::Clear();
+	MapCache::Clear();
 
 	if (is_easyrpg_project) {
 		std::string edb = FileFinder::FindDefault(DATABASE_NAME_EASYRPG);
@@ -923,9 +952,17 @@ void Player::LoadDatabase() {
 			Output::Error("Error loading {}", DATABASE_NAME_EASYRPG);
 			return;
 		}
-		auto db = lcf::LDB_Reader::LoadXml(edb_stream);
+		std::unique_ptr<lcf::rpg::Database> db;
+		std::string error;
+		{
+			auto lcf_lock = LcfLock::Acquire();
+			db = lcf::LDB_Reader::LoadXml(edb_stream);
+			if (!db) {
+				error = lcf::LcfReader::GetError();
+			}
+		}
 		if (!db) {
-			Output::ErrorStr(lcf::LcfReader::GetError());
+			Output::ErrorStr(error);
 			return;
 		} else {
 			lcf::Data::data = std::move(*db);
@@ -937,9 +974,16 @@ void Player::LoadDatabase() {
 			Output::Error("Error loading {}", TREEMAP_NAME_EASYRPG);
 			return;
 		}
-		auto treemap = lcf::LMT_Reader::LoadXml(emt_stream);
+		std::unique_ptr<lcf::rpg::TreeMap> treemap;
+		{
+			auto lcf_lock = LcfLock::Acquire();
+			treemap = lcf::LMT_Reader::LoadXml(emt_stream);
+			if (!treemap) {
+				error = lcf::LcfReader::GetError();
+			}
+		}
 		if (!treemap) {
-			Output::ErrorStr(lcf::LcfReader::GetError());
+			Output::ErrorStr(error);
 		} else {
 			lcf::Data::treemap = std::move(*treemap);
 		}
@@ -950,41 +994,62 @@ void Player::LoadDatabase() {
 		std::string lmt_name = fileext_map.MakeFilename(RPG_RT_PREFIX, SUFFIX_LMT);
 		std::string lmt = FileFinder::FindDefault(lmt_name);
 
-		auto ldb_stream = FileFinder::OpenInputStream(ldb);
+		if (Input::IsRecording()) {
+			// Hashed in the background while the files are parsed
+			FileHash::Prefetch(ldb);
+			FileHash::Prefetch(lmt);
+		}
+
+		auto ldb_stream = FileFinder::OpenMappedInputStream(ldb);
 		if (!ldb_stream) {
 			Output::Error("Error loading {}", ldb_name);
 			return;
 		}
-		auto db = lcf::LDB_Reader::Load(ldb_stream, encoding);
+		std::unique_ptr<lcf::rpg::Database> db;
+		std::string error;
+		{
+			auto lcf_lock = LcfLock::Acquire();
+			db = LcfSnapshot::LoadDatabase(ldb_name, ldb_stream, encoding);
+			if (!db) {
+				error = lcf::LcfReader::GetError();
+			}
+		}
 		if (!db) {
-			Output::ErrorStr(lcf::LcfReader::GetError());
+			Output::ErrorStr(error);
 			return;
 		} else {
 			lcf::Data::data = std::move(*db);
 		}
 
-		auto lmt_stream = FileFinder::OpenInputStream(lmt);
+		auto lmt_stream = FileFinder::OpenMappedInputStream(lmt);
 		if (!lmt_stream) {
 			Output::Error("Error loading {}", lmt_name);
 			return;
 		}
-		auto treemap = lcf::LMT_Reader::Load(lmt_stream, encoding);
+		std::unique_ptr<lcf::rpg::TreeMap> treemap;
+		{
+			auto lcf_lock = LcfLock::Acquire();
+			treemap = LcfSnapshot::LoadTreeMap(lmt_name, lmt_stream, encoding);
+			if (!treemap) {
+				error = lcf::LcfReader::GetError();
+			}
+		}
 		if (!treemap) {
-			Output::ErrorStr(lcf::LcfReader::GetError());
+			Output::ErrorStr(error);
 			return;
 		} else {
 			lcf::Data::treemap = std::move(*treemap);
 		}
 
 		if (Input::IsRecording()) {
-			ldb_stream.clear();
-			ldb_stream.seekg(0, std::ios::beg);
-			lmt_stream.clear();
-			lmt_stream.seekg(0, std::ios::beg);
+			uint32_t ldb_crc = 0;
+			uint32_t lmt_crc = 0;
+			FileHash::GetCRC32(ldb, ldb_crc);
+			FileHash::GetCRC32(lmt, lmt_crc);
 			Input::AddRecordingData(Input::RecordingData::Hash,
-									fmt::format("ldb {:#08x}", Utils::CRC32(ldb_stream)));
+									fmt::format("ldb {:#08x}", ldb_crc));
 			Input::AddRecordingData(Input::RecordingData::Hash,
-						   fmt::format("lmt {:#08x}", Utils::CRC32(lmt_stream)));
+						   fmt::format("lmt {:#08x}", lmt_crc));
 		}
 
 		// Override map extension, if needed.
@@ -1007,8 +1072,34 @@ static void OnMapSaveFileReady(FileRequestResult*, lcf::rpg::Save save) {
 			std::move(save.common_events));
 }
 
-void Player::LoadSavegame(const std::string& save_name, int save_id) {
+bool Player::LoadSavegame(const std::string& save_name, int save_id) {
+	SaveWriter::Flush();
+
 	Output::Debug("Loading Save {}", FileFinder::GetPathInsidePath(Main_Data::GetSavePath(), save_name));
+
+	// The file menus only read the title of a savegame, a corrupted savegame
+	// is only detected here. Nothing is changed before it was parsed.
+	auto save_stream = FileFinder::OpenInputStream(save_name);
+	if (!save_stream) {
+		Output::Warning("Error loading {}", save_name);
+		return false;
+	}
+
+	std::unique_ptr<lcf::rpg::Save> save;
+	std::string error;
+	{
+		auto lcf_lock = LcfLock::Acquire();
+		save = lcf::LSD_Reader::Load(save_stream, encoding);
+		if (!save) {
+			error = lcf::LcfReader::GetError();
+		}
+	}
+
+	if (!save.get()) {
+		Output::Warning("Error loading {}: {}", save_name, error);
+		return false;
+	}
+
 	Main_Data::game_system->BgmFade(800);
 
 	// We erase the screen now before loading the saved game. This prevents an issue where
@@ -1021,19 +1112,6 @@ void Player::LoadSavegame(const std::string& save_name, int save_id) {
 		static_cast<Scene_Title*>(title_scene.get())->OnGameStart();
 	}
 
-	auto save_stream = FileFinder::OpenInputStream(save_name);
-	if (!save_stream) {
-		Output::Error("Error loading {}", save_name);
-		return;
-	}
-
-	std::unique_ptr<lcf::rpg::Save> save = lcf::LSD_Reader::Load(save_stream, encoding);
-
-	if (!save.get()) {
-		Output::ErrorStr(lcf::LcfReader::GetError());
-		return;
-	}
-
 	std::stringstream verstr;
 	int ver = save->easyrpg_data.version;
 	if (ver == 0) {
@@ -1089,6 +1167,8 @@ void Player::LoadSavegame(const std::string& save_name, int save_id) {
 
 	map->Start();
 	Scene::Push(std::make_shared<Scene_Map>(save_id));
+
+	return true;
 }
 
 static void OnMapFileReady(FileRequestResult*) {
@@ -1250,6 +1330,9 @@ Options:
       --battle-test N      Start a battle test with monster party N.
       --disable-audio      Disable audio (in case you prefer your own music).
       --disable-rtp        Disable support for the Runtime Package (RTP).
+      --directory-index PATH Cache the directory listings of the game in PATH.
+                           Speeds up the startup on slow storage. Directories
+                           which changed since the last run are scanned again.
       --encoding N         Instead of auto detecting the encoding or using
                            the one in RPG_RT.ini, the encoding N is used.
                            Use "auto" for automatic detection.
@@ -1261,6 +1344,9 @@ Options:
                             rpg2k3     - RPG Maker 2003 engine (v1.00 - v1.04)
                             rpg2k3v105 - RPG Maker 2003 engine (v1.05 - v1.09a)
                             rpg2k3e    - RPG Maker 2003 (English release) engine
+      --game-list-cache PATH Cache the games found by the game browser in PATH.
+                           Only directories which changed since the last run
+                           are checked again.
       --fullscreen         Start in fullscreen mode.
       --show-fps           Enable frames per second counter.
       --fps-render-window  Render the frames per second counter in windowed mode.
@@ -1286,6 +1372,9 @@ Options:
                            When using the game browser all games will share
                            the same save directory!
       --seed N             Seeds the random number generator with N.
+      --snapshot-cache PATH Store the parsed database and maps in the directory
+                           PATH. Speeds up loading of big games. The snapshots
+                           are recreated when the game files change.
       --start-map-id N     Overwrite the map used for new games and use.
                            MapN.lmu instead (N is padded to four digits).
                            Incompatible with --load-game-id.
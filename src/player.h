@@ -148,8 +148,10 @@ namespace Player {
 	 *
 	 * @param save_file Savegame file to load
 	 * @param save_id ID of the savegame to load
+	 * @return false when the savegame is unreadable or corrupted, a warning
+	 *   is shown and the current game state is not changed
 	 */
-	void LoadSavegame(const std::string& save_file, int save_id = 0);
+	bool LoadSavegame(const std::string& save_file, int save_id = 0);
 
 	/**
 	 * Starts a new game
@@ -336,6 +338,12 @@ namespace Player {
 	/** Path to record input log to */
 	extern std::string record_input_path;
 
+	/** Path to the index of the game directory, empty when disabled */
+	extern std::string directory_index_path;
+
+	/** Path to the game list cache of the game browser, empty when disabled */
+	extern std::string game_list_cache_path;
+
 	/** The concatenated command line */
 	extern std::string command_line;
 
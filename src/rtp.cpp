@@ -19,6 +19,8 @@
 #include <array>
 #include <cassert>
 #include <cstring>
+#include <string>
+#include <unordered_map>
 #include "rtp.h"
 
 namespace RTP {
@@ -37,19 +39,6 @@ namespace RTP {
 	};
 }
 
-static std::pair<int, int> get_table_idx(const char* const lookup_table[16], const int lookup_table_idx[16], StringView category) {
-	int i;
-
-	for (i = 0; lookup_table[i] != nullptr; ++i) {
-		if (StringView(lookup_table[i]) == category) {
-			return {lookup_table_idx[i], lookup_table_idx[i+1]};
-		}
-	}
-
-	// Points at nullptr (final row) in the rtp table
-	return {lookup_table_idx[i], lookup_table_idx[i]};
-}
-
 template <typename T>
 static void detect_helper(const DirectoryTreeView& tree, std::vector<struct RTP::RtpHitInfo>& hit_list,
 		T rtp_table, int num_rtps, int offset, const std::pair<int, int>& range, Span<StringView> ext_list) {
@@ -136,41 +125,83 @@ std::vector<RTP::RtpHitInfo> RTP::Detect(const DirectoryTreeView& tree, int vers
 	return hit_list;
 }
 
-template <typename T>
-static std::vector<RTP::Type> lookup_any_to_rtp_helper(T rtp_table, const std::pair<int, int>& range,
-		StringView src_name, int num_rtps, int offset) {
-	std::vector<RTP::Type> type_hits;
+namespace {
+	/**
+	 * Hash index over a RTP table.
+	 * Maps "category/name" to the table rows and RTP columns containing the name.
+	 * The entries are in table order, this keeps the results identical to a table scan.
+	 */
+	using TableIndex = std::unordered_map<std::string, std::vector<std::pair<int, int>>>;
+
+	std::string make_key(StringView category, StringView name) {
+		std::string key;
+		key.reserve(category.size() + name.size() + 1);
+		key.append(category.data(), category.size());
+		key += '/';
+		key.append(name.data(), name.size());
+		return key;
+	}
 
-	for (int i = range.first; i < range.second; ++i) {
-		for (int j = 1; j <= num_rtps; ++j) {
-			const char* name = rtp_table[i][j];
-			if (name != nullptr && src_name == StringView(name)) {
-				type_hits.push_back((RTP::Type)(j - 1 + offset));
+	template <typename T>
+	TableIndex build_index(T rtp_table, const char* const categories[], const int categories_idx[], int num_rtps) {
+		TableIndex index;
+
+		for (int c = 0; categories[c] != nullptr; ++c) {
+			for (int i = categories_idx[c]; i < categories_idx[c + 1]; ++i) {
+				for (int j = 1; j <= num_rtps; ++j) {
+					const char* name = rtp_table[i][j];
+					if (name != nullptr) {
+						index[make_key(categories[c], name)].emplace_back(i, j);
+					}
+				}
 			}
 		}
+
+		return index;
 	}
 
-	return type_hits;
+	const TableIndex& get_index_2k() {
+		static const TableIndex index = build_index(RTP::rtp_table_2k, RTP::rtp_table_2k_categories, RTP::rtp_table_2k_categories_idx, RTP::num_2k_rtps);
+		return index;
+	}
+
+	const TableIndex& get_index_2k3() {
+		static const TableIndex index = build_index(RTP::rtp_table_2k3, RTP::rtp_table_2k3_categories, RTP::rtp_table_2k3_categories_idx, RTP::num_2k3_rtps);
+		return index;
+	}
+
+	const std::vector<std::pair<int, int>>* find_entries(const TableIndex& index, StringView category, StringView name) {
+		auto it = index.find(make_key(category, name));
+		return it == index.end() ? nullptr : &it->second;
+	}
 }
 
 std::vector<RTP::Type> RTP::LookupAnyToRtp(StringView src_category, StringView src_name, int version) {
-	if (version == 2000) {
-		auto tbl_idx = get_table_idx(rtp_table_2k_categories, rtp_table_2k_categories_idx, src_category);
-		return lookup_any_to_rtp_helper(rtp_table_2k, tbl_idx, src_name, num_2k_rtps, 0);
-	} else {
-		auto tbl_idx = get_table_idx(rtp_table_2k3_categories, rtp_table_2k3_categories_idx, src_category);
-		return lookup_any_to_rtp_helper(rtp_table_2k3, tbl_idx, src_name, num_2k3_rtps, num_2k_rtps);
+	std::vector<RTP::Type> type_hits;
+
+	const int offset = (version == 2000) ? 0 : num_2k_rtps;
+	auto* entries = find_entries(version == 2000 ? get_index_2k() : get_index_2k3(), src_category, src_name);
+	if (entries) {
+		for (const auto& entry: *entries) {
+			type_hits.push_back((RTP::Type)(entry.second - 1 + offset));
+		}
 	}
+
+	return type_hits;
 }
 
 template <typename T>
-static std::string lookup_rtp_to_rtp_helper(T rtp_table, const std::pair<int, int>& range,
+static std::string lookup_rtp_to_rtp_helper(T rtp_table, const TableIndex& index, StringView src_category,
 		StringView src_name, int src_index, int dst_index, bool* is_rtp_asset) {
+	auto* entries = find_entries(index, src_category, src_name);
 
-	for (int i = range.first; i < range.second; ++i) {
-		const char* name = rtp_table[i][src_index + 1];
-		if (name != nullptr && src_name == StringView(name)) {
-			const char* dst_name = rtp_table[i][dst_index + 1];
+	if (entries) {
+		for (const auto& entry: *entries) {
+			if (entry.second != src_index + 1) {
+				continue;
+			}
+
+			const char* dst_name = rtp_table[entry.first][dst_index + 1];
 
 			if (is_rtp_asset) {
 				*is_rtp_asset = true;
@@ -202,10 +233,8 @@ std::string RTP::LookupRtpToRtp(StringView src_category, StringView src_name, RT
 	}
 
 	if ((int)src_rtp < num_2k_rtps) {
-		auto tbl_idx = get_table_idx(rtp_table_2k_categories, rtp_table_2k_categories_idx, src_category);
-		return lookup_rtp_to_rtp_helper(rtp_table_2k, tbl_idx, src_name, (int)src_rtp, (int)target_rtp, is_rtp_asset);
+		return lookup_rtp_to_rtp_helper(rtp_table_2k, get_index_2k(), src_category, src_name, (int)src_rtp, (int)target_rtp, is_rtp_asset);
 	} else {
-		auto tbl_idx = get_table_idx(rtp_table_2k3_categories, rtp_table_2k3_categories_idx, src_category);
-		return lookup_rtp_to_rtp_helper(rtp_table_2k3, tbl_idx, src_name, (int)src_rtp - num_2k_rtps, (int)target_rtp - num_2k_rtps, is_rtp_asset);
+		return lookup_rtp_to_rtp_helper(rtp_table_2k3, get_index_2k3(), src_category, src_name, (int)src_rtp - num_2k_rtps, (int)target_rtp - num_2k_rtps, is_rtp_asset);
 	}
 }
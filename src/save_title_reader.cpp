@@ -0,0 +1,132 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "save_title_reader.h"
+#include "filefinder.h"
+#include "lcf_lock.h"
+#include "platform.h"
+#include <lcf/lsd/chunks.h>
+#include <lcf/lsd/reader.h>
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+	// Sanity limits, real files are much smaller
+	constexpr uint32_t max_header_size = 64;
+	constexpr uint32_t max_title_size = 64 * 1024;
+
+	struct CachedTitle {
+		int64_t mtime;
+		std::string encoding;
+		std::shared_ptr<const lcf::rpg::SaveTitle> title;
+	};
+
+	std::unordered_map<std::string, CachedTitle> cache;
+
+	/** Reads a BER compressed integer and appends the raw bytes to out */
+	bool ReadInt(std::istream& is, uint32_t& value, std::string& out) {
+		value = 0;
+		for (int i = 0; i < 5; ++i) {
+			int c = is.get();
+			if (c == std::char_traits<char>::eof()) {
+				return false;
+			}
+			out.push_back(static_cast<char>(c));
+			value = (value << 7) | (c & 0x7F);
+			if ((c & 0x80) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ReadBytes(std::istream& is, uint32_t size, std::string& out) {
+		size_t pos = out.size();
+		out.resize(pos + size);
+		return static_cast<bool>(is.read(&out[pos], size));
+	}
+}
+
+std::unique_ptr<lcf::rpg::SaveTitle> SaveTitleReader::Load(std::istream& is, StringView encoding) {
+	// The header and the title chunk are copied into a minimal savegame
+	// which is parsed by liblcf, all other chunks are skipped.
+	std::string data;
+
+	uint32_t header_size = 0;
+	if (!ReadInt(is, header_size, data) || header_size > max_header_size || !ReadBytes(is, header_size, data)) {
+		return nullptr;
+	}
+
+	for (;;) {
+		std::string chunk;
+		uint32_t chunk_id = 0;
+		uint32_t chunk_size = 0;
+		if (!ReadInt(is, chunk_id, chunk) || chunk_id == 0 || !ReadInt(is, chunk_size, chunk)) {
+			return nullptr;
+		}
+
+		if (chunk_id != lcf::LSD_Reader::ChunkSave::title) {
+			if (!is.seekg(chunk_size, std::ios_base::cur)) {
+				return nullptr;
+			}
+			continue;
+		}
+
+		if (chunk_size > max_title_size || !ReadBytes(is, chunk_size, chunk)) {
+			return nullptr;
+		}
+		data += chunk;
+		break;
+	}
+
+	std::istringstream title_is(data);
+	auto lcf_lock = LcfLock::Acquire();
+	auto save = lcf::LSD_Reader::Load(title_is, encoding);
+	if (!save) {
+		return nullptr;
+	}
+	return std::make_unique<lcf::rpg::SaveTitle>(std::move(save->title));
+}
+
+std::shared_ptr<const lcf::rpg::SaveTitle> SaveTitleReader::LoadCached(const std::string& path, StringView encoding) {
+	int64_t mtime = Platform::File(path).GetModificationTime();
+
+	auto it = cache.find(path);
+	if (it != cache.end() && mtime != -1 && it->second.mtime == mtime && StringView(it->second.encoding) == encoding) {
+		return it->second.title;
+	}
+
+	auto is = FileFinder::OpenInputStream(path);
+	std::shared_ptr<const lcf::rpg::SaveTitle> title;
+	if (is) {
+		title = Load(is, encoding);
+	}
+
+	if (title && mtime != -1) {
+		cache[path] = { mtime, ToString(encoding), title };
+	} else {
+		cache.erase(path);
+	}
+	return title;
+}
+
+void SaveTitleReader::Invalidate(const std::string& path) {
+	cache.erase(path);
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_SAVE_TITLE_READER_H
+#define EP_SAVE_TITLE_READER_H
+
+// Headers
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <lcf/rpg/savetitle.h>
+#include "string_view.h"
+
+/**
+ * Reads the title (party faces, hero name, level, HP and timestamp) of a
+ * savegame without parsing the rest of the savegame.
+ *
+ * The title is the first chunk of a LSD file, so only a few hundred bytes
+ * are read instead of the whole map and party state.
+ */
+namespace SaveTitleReader {
+	/**
+	 * Reads the title chunk of a savegame.
+	 *
+	 * @param is stream of the LSD file
+	 * @param encoding encoding of the savegame
+	 * @return title or nullptr when the title chunk is missing or corrupted
+	 */
+	std::unique_ptr<lcf::rpg::SaveTitle> Load(std::istream& is, StringView encoding);
+
+	/**
+	 * Like Load but remembers the title of the file. The title is read
+	 * again when the modification time of the file changes.
+	 *
+	 * @param path path to the LSD file
+	 * @param encoding encoding of the savegame
+	 * @return title or nullptr when the file is not readable or corrupted
+	 */
+	std::shared_ptr<const lcf::rpg::SaveTitle> LoadCached(const std::string& path, StringView encoding);
+
+	/**
+	 * Forgets the remembered title of a file, must be called after writing
+	 * a savegame.
+	 *
+	 * @param path path to the LSD file
+	 */
+	void Invalidate(const std::string& path);
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "save_writer.h"
+#include "filefinder.h"
+#include "lcf_lock.h"
+#include "output.h"
+#include "platform.h"
+#include "system.h"
+#include <vector>
+
+#ifdef SUPPORT_THREADS
+#  include <condition_variable>
+#  include <deque>
+#  include <mutex>
+#  include <thread>
+#endif
+
+namespace {
+	struct SaveJob {
+		std::string filename;
+		lcf::rpg::Save save;
+		lcf::EngineVersion engine;
+		std::string encoding;
+	};
+
+	/** Writes the savegame, must not use Output because it runs on the worker */
+	bool WriteSave(const SaveJob& job) {
+		std::string tmp_filename = job.filename + ".tmp";
+		{
+			auto os = FileFinder::OpenOutputStream(tmp_filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+			auto lcf_lock = LcfLock::Acquire();
+			if (!os || !lcf::LSD_Reader::Save(os, job.save, job.engine, job.encoding) || !os.flush()) {
+				return false;
+			}
+		}
+		// Otherwise a power loss after the rename can leave an empty savegame behind
+		Platform::File tmp_file(tmp_filename);
+		return tmp_file.Sync() && tmp_file.Rename(job.filename);
+	}
+
+	std::vector<std::string> failed_saves;
+
+#ifdef SUPPORT_THREADS
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<SaveJob> jobs;
+	bool busy = false;
+	bool quit = false;
+
+	void WorkerMain() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			cv.wait(lock, [] { return quit || !jobs.empty(); });
+			if (jobs.empty()) {
+				return;
+			}
+
+			SaveJob job = std::move(jobs.front());
+			jobs.pop_front();
+			busy = true;
+			lock.unlock();
+
+			bool success = WriteSave(job);
+
+			lock.lock();
+			busy = false;
+			if (!success) {
+				failed_saves.push_back(std::move(job.filename));
+			}
+			cv.notify_all();
+		}
+	}
+
+	/**
+	 * Owns the worker thread and stops it on destruction after all queued
+	 * savegames are written. This also happens when exit() is called while
+	 * the worker runs, e.g. by Output::Error.
+	 */
+	struct Worker {
+		std::thread thread;
+
+		~Worker() {
+			Stop();
+		}
+
+		void Start() {
+			if (!thread.joinable()) {
+				thread = std::thread(WorkerMain);
+			}
+		}
+
+		void Stop() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+				cv.notify_all();
+			}
+			if (thread.joinable()) {
+				thread.join();
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = false;
+		}
+	};
+
+	Worker& GetWorker() {
+		// Constructed on first use, so it is destroyed before the other globals
+		static Worker worker;
+		return worker;
+	}
+#endif
+
+	void ReportFailures() {
+		for (const auto& filename: failed_saves) {
+			Output::Warning("Failed saving to {}", filename);
+		}
+		failed_saves.clear();
+	}
+}
+
+void SaveWriter::Write(std::string filename, lcf::rpg::Save save, lcf::EngineVersion engine, std::string encoding) {
+	SaveJob job { std::move(filename), std::move(save), engine, std::move(encoding) };
+
+#ifdef SUPPORT_THREADS
+	std::lock_guard<std::mutex> lock(mutex);
+	// A newer save of the same slot supersedes a queued one
+	for (auto& queued: jobs) {
+		if (queued.filename == job.filename) {
+			queued = std::move(job);
+			return;
+		}
+	}
+	jobs.push_back(std::move(job));
+	GetWorker().Start();
+	cv.notify_all();
+#else
+	if (!WriteSave(job)) {
+		failed_saves.push_back(std::move(job.filename));
+	}
+	ReportFailures();
+#endif
+}
+
+void SaveWriter::Flush() {
+#ifdef SUPPORT_THREADS
+	std::unique_lock<std::mutex> lock(mutex);
+	cv.wait(lock, [] { return jobs.empty() && !busy; });
+#endif
+	ReportFailures();
+}
+
+void SaveWriter::Quit() {
+#ifdef SUPPORT_THREADS
+	GetWorker().Stop();
+#endif
+	ReportFailures();
+}
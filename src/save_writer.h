@@ -0,0 +1,57 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_SAVE_WRITER_H
+#define EP_SAVE_WRITER_H
+
+// Headers
+#include <string>
+#include <lcf/lsd/reader.h>
+#include <lcf/rpg/save.h>
+
+/**
+ * Writes savegames on a background thread.
+ *
+ * The caller creates the lcf::rpg::Save on the main thread, encoding and
+ * writing it to disk happens in the background. Savegames are written to
+ * a temporary file which is synced to the storage and renamed afterwards,
+ * an interrupted write or a power loss never replaces an existing savegame.
+ *
+ * On platforms without thread support the savegame is written immediately.
+ */
+namespace SaveWriter {
+	/**
+	 * Queues a savegame for writing.
+	 *
+	 * @param filename path of the savegame
+	 * @param save savegame data
+	 * @param engine engine version of the savegame
+	 * @param encoding encoding of the savegame
+	 */
+	void Write(std::string filename, lcf::rpg::Save save, lcf::EngineVersion engine, std::string encoding);
+
+	/**
+	 * Waits until all queued savegames are written and reports failed writes.
+	 * Must be called before savegames are read.
+	 */
+	void Flush();
+
+	/** Writes all queued savegames and stops the background thread */
+	void Quit();
+}
+
+#endif
@@ -25,8 +25,9 @@
 #include "game_system.h"
 #include "game_party.h"
 #include "input.h"
-#include <lcf/lsd/reader.h>
 #include "player.h"
+#include "save_title_reader.h"
+#include "save_writer.h"
 #include "scene_file.h"
 #include "bitmap.h"
 #include <lcf/reader_util.h>
@@ -67,14 +68,14 @@ void Scene_File::CreateHelpWindow() {
 	help_window->SetZ(Priority_Window + 1);
 }
 
-void Scene_File::PopulatePartyFaces(Window_SaveFile& win, int /* id */, lcf::rpg::Save& savegame) {
-	win.SetParty(savegame.title);
+void Scene_File::PopulatePartyFaces(Window_SaveFile& win, int /* id */, const lcf::rpg::SaveTitle& title) {
+	win.SetParty(title);
 	win.SetHasSave(true);
 }
 
-void Scene_File::UpdateLatestTimestamp(int id, lcf::rpg::Save& savegame) {
-	if (savegame.title.timestamp > latest_time) {
-		latest_time = savegame.title.timestamp;
+void Scene_File::UpdateLatestTimestamp(int id, const lcf::rpg::SaveTitle& title) {
+	if (title.timestamp > latest_time) {
+		latest_time = title.timestamp;
 		latest_slot = id;
 	}
 }
@@ -87,19 +88,12 @@ void Scene_File::PopulateSaveWindow(Window_SaveFile& win, int id) {
 	std::string file = tree->FindFile(ss.str());
 
 	if (!file.empty()) {
-		// File found
-		auto save_stream = FileFinder::OpenInputStream(file);
-		if (!save_stream) {
-			Output::Debug("Save {} read error", file);
-			win.SetCorrupted(true);
-			return;
-		}
+		// File found, only the title is needed for the window
+		auto title = SaveTitleReader::LoadCached(file, Player::encoding);
 
-		std::unique_ptr<lcf::rpg::Save> savegame = lcf::LSD_Reader::Load(save_stream, Player::encoding);
-
-		if (savegame) {
-			PopulatePartyFaces(win, id, *savegame);
-			UpdateLatestTimestamp(id, *savegame);
+		if (title) {
+			PopulatePartyFaces(win, id, *title);
+			UpdateLatestTimestamp(id, *title);
 		} else {
 			Output::Debug("Save {} corrupted", file);
 			win.SetCorrupted(true);
@@ -111,6 +105,9 @@ void Scene_File::Start() {
 	CreateHelpWindow();
 	border_top = Scene_File::MakeBorderSprite(32);
 
+	// Savegames written in the background must be visible
+	SaveWriter::Flush();
+
 	// Refresh File Finder Save Folder
 	tree = FileFinder::CreateSaveDirectoryTree();
 
@@ -53,8 +53,8 @@ public:
 protected:
 	virtual void CreateHelpWindow();
 	virtual void PopulateSaveWindow(Window_SaveFile& win, int id);
-	virtual void PopulatePartyFaces(Window_SaveFile& win, int id, lcf::rpg::Save& savegame);
-	virtual void UpdateLatestTimestamp(int id, lcf::rpg::Save& savegame);
+	virtual void PopulatePartyFaces(Window_SaveFile& win, int id, const lcf::rpg::SaveTitle& title);
+	virtual void UpdateLatestTimestamp(int id, const lcf::rpg::SaveTitle& title);
 	static std::unique_ptr<Sprite> MakeBorderSprite(int y);
 	static std::unique_ptr<Sprite> MakeArrowSprite(bool down);
 
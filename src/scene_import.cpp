@@ -20,9 +20,9 @@
 #include "filefinder.h"
 #include "game_system.h"
 #include "input.h"
-#include <lcf/lsd/reader.h>
 #include "output.h"
 #include "player.h"
+#include "save_title_reader.h"
 #include "scene_file.h"
 #include "scene_import.h"
 
@@ -36,12 +36,11 @@ void Scene_Import::PopulateSaveWindow(Window_SaveFile& win, int id) {
 	if (id < static_cast<int>(files.size())) {
 		win.SetDisplayOverride(files[id].short_path, files[id].file_id);
 
-		std::unique_ptr<lcf::rpg::Save> savegame =
-			lcf::LSD_Reader::Load(files[id].full_path, Player::encoding);
+		auto title = SaveTitleReader::LoadCached(files[id].full_path, Player::encoding);
 
-		if (savegame.get()) {
-			PopulatePartyFaces(win, id, *savegame);
-			UpdateLatestTimestamp(id, *savegame);
+		if (title) {
+			PopulatePartyFaces(win, id, *title);
+			UpdateLatestTimestamp(id, *title);
 		} else {
 			win.SetCorrupted(true);
 		}
@@ -136,9 +135,13 @@ void Scene_Import::FinishScan() {
 }
 
 void Scene_Import::Action(int index) {
-	Player::LoadSavegame(files[index].full_path);
+	if (!Player::LoadSavegame(files[index].full_path)) {
+		file_windows[index]->SetCorrupted(true);
+		file_windows[index]->Refresh();
+		Main_Data::game_system->SePlay(Main_Data::game_system->GetSystemSE(Main_Data::game_system->SFX_Buzzer));
+	}
 }
 
 bool Scene_Import::IsSlotValid(int index) {
-	return index < static_cast<int>(files.size());
+	return index < static_cast<int>(files.size()) && file_windows[index]->IsValid();
 }
@@ -18,6 +18,7 @@
 // Headers
 #include <sstream>
 #include "filefinder.h"
+#include "game_system.h"
 #include "output.h"
 #include "player.h"
 #include "scene_load.h"
@@ -31,7 +32,11 @@ Scene_Load::Scene_Load() :
 void Scene_Load::Action(int index) {
 	std::string save_name = tree->FindFile(fmt::format("Save{:02d}.lsd", index + 1));
 
-	Player::LoadSavegame(save_name, index + 1);
+	if (!Player::LoadSavegame(save_name, index + 1)) {
+		file_windows[index]->SetCorrupted(true);
+		file_windows[index]->Refresh();
+		Main_Data::game_system->SePlay(Main_Data::game_system->GetSystemSE(Main_Data::game_system->SFX_Buzzer));
+	}
 }
 
 bool Scene_Load::IsSlotValid(int index) {
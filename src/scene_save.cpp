@@ -37,8 +37,11 @@
 #include "game_screen.h"
 #include "game_pictures.h"
 #include <lcf/lsd/reader.h>
+#include "lcf_lock.h"
 #include "output.h"
 #include "player.h"
+#include "save_title_reader.h"
+#include "save_writer.h"
 #include "scene_save.h"
 #include "version.h"
 
@@ -77,17 +80,28 @@ std::string Scene_Save::GetSaveFilename(const DirectoryTreeView& tree, int slot_
 
 void Scene_Save::Save(const DirectoryTreeView& tree, int slot_id, bool prepare_save) {
 	const auto filename = GetSaveFilename(tree, slot_id);
-	auto save_stream = FileFinder::OpenOutputStream(filename);
-	if (!save_stream) {
-		Output::Warning("Failed saving to {}", filename);
-		return;
-	}
 
-	Save(save_stream, slot_id, prepare_save);
+	// Only collecting the state happens here, encoding and writing is done in the background
+	auto lcf_engine = Player::IsRPG2k3() ? lcf::EngineVersion::e2k3 : lcf::EngineVersion::e2k;
+	SaveWriter::Write(filename, CreateSaveGame(slot_id, prepare_save), lcf_engine, Player::encoding);
+	SaveTitleReader::Invalidate(filename);
+
+	FinishSave(slot_id);
 }
 
 void Scene_Save::Save(std::ostream& os, int slot_id, bool prepare_save) {
+	auto save = CreateSaveGame(slot_id, prepare_save);
+
+	auto lcf_engine = Player::IsRPG2k3() ? lcf::EngineVersion::e2k3 : lcf::EngineVersion::e2k;
+	{
+		auto lcf_lock = LcfLock::Acquire();
+		lcf::LSD_Reader::Save(os, save, lcf_engine, Player::encoding);
+	}
 
+	FinishSave(slot_id);
+}
+
+lcf::rpg::Save Scene_Save::CreateSaveGame(int slot_id, bool prepare_save) {
 	lcf::rpg::Save save;
 	auto& title = save.title;
 	// TODO: Maybe find a better place to setup the save file?
@@ -146,9 +160,11 @@ void Scene_Save::Save(std::ostream& os, int slot_id, bool prepare_save) {
 			sme.map_id = 0;
 		}
 	}
-	auto lcf_engine = Player::IsRPG2k3() ? lcf::EngineVersion::e2k3 : lcf::EngineVersion::e2k;
-	lcf::LSD_Reader::Save(os, save, lcf_engine, Player::encoding);
 
+	return save;
+}
+
+void Scene_Save::FinishSave(int slot_id) {
 	DynRpg::Save(slot_id);
 
 #ifdef EMSCRIPTEN
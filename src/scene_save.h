@@ -42,6 +42,10 @@ public:
 	static std::string GetSaveFilename(const DirectoryTreeView& tree, int slot_id);
 	static void Save(const DirectoryTreeView& tree, int slot_id, bool prepare_save = true);
 	static void Save(std::ostream& os, int slot_id, bool prepare_save = true);
+
+private:
+	static lcf::rpg::Save CreateSaveGame(int slot_id, bool prepare_save);
+	static void FinishSave(int slot_id);
 };
 
 #endif
@@ -122,10 +122,15 @@
 
 #endif
 
-#if defined(HAVE_LIBSAMPLERATE) || defined(HAVE_LIBSPEEXDSP)
+#if defined(HAVE_LIBSAMPLERATE) || defined(HAVE_LIBSPEEXDSP) || defined(WANT_BUILTIN_RESAMPLER)
 #  define USE_AUDIO_RESAMPLER
 #endif
 
+// Background work with std::thread, not usable on single threaded targets
+#if !(defined(EMSCRIPTEN) || defined(GEKKO) || defined(_3DS) || defined(PSP2) || defined(USE_LIBRETRO))
+#  define SUPPORT_THREADS
+#endif
+
 #endif
 
 #if defined(__APPLE__) && defined(__MACH__)
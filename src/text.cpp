@@ -24,9 +24,111 @@
 #include "font.h"
 #include "text.h"
 #include "compiler.h"
+#include "lru_cache.h"
 
 #include <cctype>
 #include <iterator>
+#include <tuple>
+
+namespace {
+	/**
+	 * Cache of rendered text lines (glyphs and shadow) drawn with a system
+	 * graphic. Windows redraw the same lines (item names, status values)
+	 * on every refresh.
+	 * Fonts are global objects, their address is a stable key.
+	 * Key is font, system graphic id, color and text.
+	 */
+	using LineKey = std::tuple<const Font*, uint32_t, int, std::string>;
+
+	struct CachedLine {
+		BitmapRef bitmap;
+		/** Width of the glyphs, excluding the shadow */
+		int width;
+	};
+
+	// Memory limit of the line cache in bytes
+	constexpr size_t line_cache_limit = 2 * 1024 * 1024;
+	size_t line_cache_size = 0;
+
+	LruCache<LineKey, CachedLine, TupleHash> line_cache;
+
+	size_t LineBytes(const Bitmap& bm) {
+		return static_cast<size_t>(bm.pitch()) * bm.height();
+	}
+
+	const CachedLine& RenderLine(Font& font, const Bitmap& system, int color, StringView text, int width, int height) {
+		LineKey key { &font, system.GetId(), color, ToString(text) };
+
+		if (auto* cached = line_cache.Find(key)) {
+			return *cached;
+		}
+
+		// Need place for shadow
+		auto bitmap = Bitmap::Create(width + 1, height + 1, true);
+
+		// This loops always renders a single char, color blends it and then puts
+		// it onto the line bitmap (including the drop shadow)
+		int next_glyph_pos = 0;
+		auto iter = text.data();
+		const auto end = iter + text.size();
+		while (iter != end) {
+			auto ret = Utils::TextNext(iter, end, 0);
+
+			iter = ret.next;
+			if (EP_UNLIKELY(!ret)) {
+				continue;
+			}
+			next_glyph_pos += Text::Draw(*bitmap, next_glyph_pos, 0, font, system, color, ret.ch, ret.is_exfont).width;
+		}
+
+		line_cache_size += LineBytes(*bitmap);
+		auto& line = line_cache.Insert(std::move(key), { std::move(bitmap), next_glyph_pos });
+
+		// Keep the line which was just added
+		while (line_cache_size > line_cache_limit && line_cache.Size() > 1) {
+			line_cache_size -= LineBytes(*line_cache.Oldest().bitmap);
+			line_cache.RemoveOldest();
+		}
+
+		return line;
+	}
+
+	/**
+	 * Cache of measured strings. Alignment, word wrapping and window
+	 * layout measure the same strings on every refresh.
+	 * Key is font and text.
+	 */
+	using SizeKey = std::tuple<const Font*, std::string>;
+
+	// Maximum amount of measured strings
+	constexpr size_t size_cache_limit = 1024;
+
+	LruCache<SizeKey, Rect, TupleHash> size_cache;
+}
+
+void Text::ClearCache() {
+	line_cache.Clear();
+	line_cache_size = 0;
+
+	size_cache.Clear();
+}
+
+Rect Text::GetSize(const Font& font, StringView text) {
+	SizeKey key { &font, ToString(text) };
+
+	if (auto* cached = size_cache.Find(key)) {
+		return *cached;
+	}
+
+	Rect size = font.GetSize(text);
+	size_cache.Insert(std::move(key), size);
+
+	if (size_cache.Size() > size_cache_limit) {
+		size_cache.RemoveOldest();
+	}
+
+	return size;
+}
 
 Rect Text::Draw(Bitmap& dest, int x, int y, Font& font, const Bitmap& system, int color, char32_t ch, bool is_exfont) {
 	if (is_exfont) {
@@ -47,8 +149,9 @@ Rect Text::Draw(Bitmap& dest, int x, int y, Font& font, Color color, char32_t ch
 Rect Text::Draw(Bitmap& dest, const int x, const int y, Font& font, const Bitmap& system, const int color, StringView text, const Text::Alignment align) {
 	if (text.length() == 0) return { x, y, 0, 0 };
 
-	Rect dst_rect = font.GetSize(text);
+	Rect dst_rect = Text::GetSize(font, text);
 
+	const int iw = dst_rect.width;
 	const int ih = dst_rect.height;
 
 	switch (align) {
@@ -68,23 +171,10 @@ Rect Text::Draw(Bitmap& dest, const int x, const int y, Font& font, const Bitmap
 	const int iy = dst_rect.y;
 	const int ix = dst_rect.x;
 
-	// Where to draw the next glyph (x pos)
-	int next_glyph_pos = 0;
+	const auto& line = RenderLine(font, system, color, text, iw, ih);
+	dest.Blit(ix, iy, *line.bitmap, line.bitmap->GetRect(), Opacity::Opaque());
 
-	// This loops always renders a single char, color blends it and then puts
-	// it onto the text_surface (including the drop shadow)
-	auto iter = text.data();
-	const auto end = iter + text.size();
-	while (iter != end) {
-		auto ret = Utils::TextNext(iter, end, 0);
-
-		iter = ret.next;
-		if (EP_UNLIKELY(!ret)) {
-			continue;
-		}
-		next_glyph_pos += Text::Draw(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, ret.is_exfont).width;
-	}
-	return { x, y, next_glyph_pos, ih };
+	return { x, y, line.width, ih };
 }
 
 Rect Text::Draw(Bitmap& dest, const int x, const int y, Font& font, const Color color, StringView text) {
@@ -100,5 +100,23 @@ namespace Text {
 	 * @return Rect describing the sub-rect of dest that was rendered to. Does *not* include shadow pixels.
 	 */
 	Rect Draw(Bitmap& dest, int x, int y, Font& font, Color color, char32_t ch, bool is_exfont);
+
+	/**
+	 * Returns the size of the rendered text, not including shadows.
+	 * Same as Font::GetSize but the result is cached per font and text.
+	 *
+	 * @param font the font used to render.
+	 * @param text the utf8 text to measure.
+	 *
+	 * @return Rect describing the rendered text boundary
+	 */
+	Rect GetSize(const Font& font, StringView text);
+
+	/**
+	 * Frees the cache of rendered text lines and of measured text.
+	 * Text drawn with a system graphic is rendered once per line and reused
+	 * while the font, system graphic, color and text stay the same.
+	 */
+	void ClearCache();
 }
 #endif
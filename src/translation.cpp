@@ -204,18 +204,16 @@ bool Translation::ParseLanguageFiles(const std::string& lang_id)
 				ParsePoFile(std::move(is), *mapnames);
 			}
 		} else {
-			std::unique_ptr<Dictionary> dict;
-			dict = std::make_unique<Dictionary>();
-			auto is = FileFinder::OpenInputStream(language_tree.FindFile(tr_name.first));
-			if (is) {
-				ParsePoFile(std::move(is), *dict);
-				maps[tr_name.first] = std::move(dict);
+			// Map translations are only needed when the map is loaded
+			std::string path = language_tree.FindFile(tr_name.first);
+			if (!path.empty()) {
+				map_files[tr_name.first] = std::move(path);
 			}
 		}
 	}
 
 	// Log
-	Output::Debug("Translation loaded {} sys, {} common, {} battle, and {} map .po files", (sys==nullptr?0:1), (battle==nullptr?0:1), (common==nullptr?0:1), maps.size());
+	Output::Debug("Translation loaded {} sys, {} common, {} battle, and found {} map .po files", (sys==nullptr?0:1), (battle==nullptr?0:1), (common==nullptr?0:1), map_files.size());
 	return true;
 }
 
@@ -624,17 +622,40 @@ void Translation::RewriteEventCommandMessage(const Dictionary& dict, std::vector
 
 void Translation::RewriteMapMessages(const std::string& map_name, lcf::rpg::Map& map) {
 	// Retrieve lookup for this map.
-	auto mapIt = maps.find(map_name);
-	if (mapIt==maps.end()) { return; }
+	const Dictionary* dict = GetMapDictionary(map_name);
+	if (!dict) { return; }
 
 	// Rewrite all event commands on all pages.
 	for (lcf::rpg::Event& ev : map.events) {
 		for (lcf::rpg::EventPage& pg : ev.pages) {
-			RewriteEventCommandMessage(*mapIt->second, pg.event_commands);
+			RewriteEventCommandMessage(*dict, pg.event_commands);
 		}
 	}
 }
 
+const Dictionary* Translation::GetMapDictionary(const std::string& map_name) {
+	if (map_dict && map_dict_name == map_name) {
+		return map_dict.get();
+	}
+
+	auto mapIt = map_files.find(map_name);
+	if (mapIt == map_files.end()) {
+		return nullptr;
+	}
+
+	auto is = FileFinder::OpenInputStream(mapIt->second);
+	if (!is) {
+		return nullptr;
+	}
+
+	// Only the dictionary of the current map is kept in memory
+	map_dict = std::make_unique<Dictionary>();
+	map_dict_name = map_name;
+	ParsePoFile(std::move(is), *map_dict);
+
+	return map_dict.get();
+}
+
 void Translation::ParsePoFile(Filesystem_Stream::InputStream is, Dictionary& out)
 {
 	if (is.good()) {
@@ -651,7 +672,9 @@ void Translation::ClearTranslationLookups()
 	common.reset();
 	battle.reset();
 	mapnames.reset();
-	maps.clear();
+	map_files.clear();
+	map_dict.reset();
+	map_dict_name.clear();
 }
 
 
@@ -265,6 +265,15 @@ private:
 	 */
 	void RewriteEventCommandMessage(const Dictionary& dict, std::vector<lcf::rpg::EventCommand>& commands);
 
+	/**
+	 * Retrieves the dictionary of a map, parsing its .po file on first use.
+	 * The dictionary of the previously used map is released.
+	 *
+	 * @param map_name The name of the map .po file; e.g., "map0104.po"
+	 * @return The dictionary, or nullptr if the map has no translation
+	 */
+	const Dictionary* GetMapDictionary(const std::string& map_name);
+
 
 private:
 	// Our translations are broken apart into multiple files; we store a lookup for each one.
@@ -272,7 +281,9 @@ private:
 	std::unique_ptr<Dictionary> common;    // RPG_RT.ldb.common.po
 	std::unique_ptr<Dictionary> battle;    // RPG_RT.ldb.battle.po
 	std::unique_ptr<Dictionary> mapnames;  // RPG_RT.lmt.po (map names, used only in the "Teleport" event command)
-	std::unordered_map<std::string, std::unique_ptr<Dictionary>> maps;  // map<id>.po, indexed by map name
+	std::unordered_map<std::string, std::string> map_files;  // map<id>.po paths, indexed by map name
+	std::unique_ptr<Dictionary> map_dict;  // Dictionary of the most recently loaded map
+	std::string map_dict_name;
 
 	// Our list of available Languages (translations, localizations), determined by scanning the files on disk.
 	std::vector<Language> languages;
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <random>
 #include <cctype>
+#include <cstring>
 #include <zlib.h>
 
 namespace {
@@ -45,6 +46,26 @@ namespace {
 		}
 	};
 
+	/**
+	 * Returns the length of the ASCII run at the start of [begin, end).
+	 * Most strings of a game are mostly ASCII, checking 8 bytes at once
+	 * skips the multibyte decoder for them.
+	 */
+	size_t AsciiPrefixLength(const char* begin, const char* end) {
+		const char* iter = begin;
+		while (end - iter >= 8) {
+			uint64_t chunk;
+			std::memcpy(&chunk, iter, sizeof(chunk));
+			if (chunk & UINT64_C(0x8080808080808080)) {
+				break;
+			}
+			iter += 8;
+		}
+		while (iter != end && static_cast<uint8_t>(*iter) < 0x80) {
+			++iter;
+		}
+		return iter - begin;
+	}
 }
 
 std::string Utils::LowerCase(StringView str) {
@@ -95,10 +116,14 @@ int Utils::StrICmp(StringView l, StringView r) {
 
 std::u16string Utils::DecodeUTF16(StringView str) {
 	std::u16string result;
+	// Upper bound, every byte is at most one code unit
+	result.reserve(str.size());
 	for (auto it = str.begin(), str_end = str.end(); it < str_end; ++it) {
 		uint8_t c1 = *it;
 		if (c1 < 0x80) {
-			result.push_back(static_cast<uint16_t>(c1));
+			auto len = AsciiPrefixLength(&*it, str.data() + str.size());
+			result.append(it, it + len);
+			it += len - 1;
 		}
 		else if (c1 < 0xC2) {
 			continue;
@@ -170,10 +195,14 @@ std::u16string Utils::DecodeUTF16(StringView str) {
 
 std::u32string Utils::DecodeUTF32(StringView str) {
 	std::u32string result;
+	// Upper bound, every byte is at most one code unit
+	result.reserve(str.size());
 	for (auto it = str.begin(), str_end = str.end(); it < str_end; ++it) {
 		uint8_t c1 = *it;
 		if (c1 < 0x80) {
-			result.push_back(static_cast<uint32_t>(c1));
+			auto len = AsciiPrefixLength(&*it, str.data() + str.size());
+			result.append(it, it + len);
+			it += len - 1;
 		}
 		else if (c1 < 0xC2) {
 			continue;
@@ -237,6 +266,7 @@ std::u32string Utils::DecodeUTF32(StringView str) {
 
 std::string Utils::EncodeUTF(const std::u16string& str) {
 	std::string result;
+	result.reserve(str.size());
 	for (auto it = str.begin(), str_end = str.end(); it < str_end; ++it) {
 		uint16_t wc1 = *it;
 		if (wc1 < 0x0080) {
@@ -280,6 +310,7 @@ std::string Utils::EncodeUTF(const std::u16string& str) {
 
 std::string Utils::EncodeUTF(const std::u32string& str) {
 	std::string result;
+	result.reserve(str.size());
 	for (const char32_t& wc : str) {
 		if ((wc & 0xFFFFF800) == 0x00D800 || wc > 0x10FFFF)
 			break;
@@ -568,6 +599,17 @@ std::vector<uint8_t> Utils::ReadStream(std::istream& stream) {
 	constexpr int buffer_incr = 8192;
 	std::vector<uint8_t> outbuf;
 
+	// Memory backed streams report the whole remaining size, read it at once
+	std::streamsize avail = stream.rdbuf() ? stream.rdbuf()->in_avail() : 0;
+	if (avail > buffer_incr) {
+		outbuf.resize(avail);
+		stream.read(reinterpret_cast<char*>(outbuf.data()), avail);
+		outbuf.resize(stream.gcount());
+		if (stream.gcount() < avail) {
+			return outbuf;
+		}
+	}
+
 	do {
 		outbuf.resize(outbuf.size() + buffer_incr);
 		stream.read(reinterpret_cast<char*>(outbuf.data() + outbuf.size() - buffer_incr), buffer_incr);
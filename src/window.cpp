@@ -18,6 +18,8 @@
 // Headers
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <map>
+#include <tuple>
 #include "system.h"
 #include "player.h"
 #include "rect.h"
@@ -28,6 +30,52 @@
 
 constexpr int pause_animation_frames = 20;
 
+namespace {
+	/** Parts of a window composed from the windowskin */
+	enum class SkinPart {
+		BackgroundStretch,
+		BackgroundTiled,
+		FrameUp,
+		FrameDown,
+		FrameLeft,
+		FrameRight,
+		Cursor1,
+		Cursor2
+	};
+
+	// Composed parts are shared between all windows with the same skin and size.
+	// Bitmaps are identified by id, addresses are reused after freeing.
+	using skin_key_type = std::tuple<uint32_t, SkinPart, int, int>;
+	std::map<skin_key_type, std::weak_ptr<Bitmap>> skin_cache;
+
+	// Number of entries after which unused parts are removed from the cache
+	constexpr size_t skin_cache_prune_size = 128;
+
+	template <typename F>
+	BitmapRef GetSkinPart(const Bitmap& windowskin, SkinPart part, int width, int height, F&& create) {
+		auto& entry = skin_cache[skin_key_type(windowskin.GetId(), part, width, height)];
+		BitmapRef bitmap = entry.lock();
+		if (bitmap) {
+			return bitmap;
+		}
+
+		bitmap = create();
+		entry = bitmap;
+
+		if (skin_cache.size() > skin_cache_prune_size) {
+			for (auto it = skin_cache.begin(); it != skin_cache.end(); ) {
+				if (it->second.expired()) {
+					it = skin_cache.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		return bitmap;
+	}
+}
+
 Window::Window(Drawable::Flags flags): Drawable(Priority_Window, flags)
 {
 	DrawableMgr::Register(this);
@@ -159,72 +207,78 @@ void Window::Draw(Bitmap& dst) {
 void Window::RefreshBackground() {
 	background_needs_refresh = false;
 
-	BitmapRef bitmap = Bitmap::Create(width, height, false);
+	auto part = stretch ? SkinPart::BackgroundStretch : SkinPart::BackgroundTiled;
+	background = GetSkinPart(*windowskin, part, width, height, [&]() {
+		BitmapRef bitmap = Bitmap::Create(width, height, false);
 
-	if (stretch) {
-		bitmap->StretchBlit(*windowskin, Rect(0, 0, 32, 32), 255);
-	} else {
-		bitmap->TiledBlit(Rect(0, 0, 32, 32), *windowskin, bitmap->GetRect(), 255);
-	}
-
-	background = bitmap;
+		if (stretch) {
+			bitmap->StretchBlit(*windowskin, Rect(0, 0, 32, 32), 255);
+		} else {
+			bitmap->TiledBlit(Rect(0, 0, 32, 32), *windowskin, bitmap->GetRect(), 255);
+		}
+		return bitmap;
+	});
 }
 
 void Window::RefreshFrame() {
 	frame_needs_refresh = false;
 
-	BitmapRef up_bitmap = Bitmap::Create(width, 8);
-	BitmapRef down_bitmap = Bitmap::Create(width, 8);
-
-	up_bitmap->Clear();
-	down_bitmap->Clear();
+	frame_up = GetSkinPart(*windowskin, SkinPart::FrameUp, width, 8, [&]() {
+		BitmapRef up_bitmap = Bitmap::Create(width, 8);
+		up_bitmap->Clear();
 
-	Rect src_rect, dst_rect;
+		// Border Up
+		Rect src_rect = { 32 + 8, 0, 16, 8 };
+		Rect dst_rect = { 8, 0, max(width - 16, 1), 8 };
+		up_bitmap->TiledBlit(8, 0, src_rect, *windowskin, dst_rect, 255);
 
-	// Border Up
-	src_rect = { 32 + 8, 0, 16, 8 };
-	dst_rect = { 8, 0, max(width - 16, 1), 8 };
-	up_bitmap->TiledBlit(8, 0, src_rect, *windowskin, dst_rect, 255);
+		// Upper left corner
+		up_bitmap->Blit(0, 0, *windowskin, Rect(32, 0, 8, 8), 255);
 
-	// Border Down
-	src_rect = { 32 + 8, 32 - 8, 16, 8 };
-	dst_rect = { 8, 0, max(width - 16, 1), 8 };
-	down_bitmap->TiledBlit(8, 0, src_rect, *windowskin, dst_rect, 255);
+		// Upper right corner
+		up_bitmap->Blit(width - 8, 0, *windowskin, Rect(64 - 8, 0, 8, 8), 255);
+		return up_bitmap;
+	});
 
-	// Upper left corner
-	up_bitmap->Blit(0, 0, *windowskin, Rect(32, 0, 8, 8), 255);
+	frame_down = GetSkinPart(*windowskin, SkinPart::FrameDown, width, 8, [&]() {
+		BitmapRef down_bitmap = Bitmap::Create(width, 8);
+		down_bitmap->Clear();
 
-	// Upper right corner
-	up_bitmap->Blit(width - 8, 0, *windowskin, Rect(64 - 8, 0, 8, 8), 255);
+		// Border Down
+		Rect src_rect = { 32 + 8, 32 - 8, 16, 8 };
+		Rect dst_rect = { 8, 0, max(width - 16, 1), 8 };
+		down_bitmap->TiledBlit(8, 0, src_rect, *windowskin, dst_rect, 255);
 
-	// Lower left corner
-	down_bitmap->Blit(0, 0, *windowskin, Rect(32, 32 - 8, 8, 8), 255);
+		// Lower left corner
+		down_bitmap->Blit(0, 0, *windowskin, Rect(32, 32 - 8, 8, 8), 255);
 
-	// Lower right corner
-	down_bitmap->Blit(width - 8, 0, *windowskin, Rect(64 - 8, 32 - 8, 8, 8), 255);
-
-	frame_up = up_bitmap;
-	frame_down = down_bitmap;
+		// Lower right corner
+		down_bitmap->Blit(width - 8, 0, *windowskin, Rect(64 - 8, 32 - 8, 8, 8), 255);
+		return down_bitmap;
+	});
 
 	if (height > 16) {
-		BitmapRef left_bitmap = Bitmap::Create(8, height - 16);
-		BitmapRef right_bitmap = Bitmap::Create(8, height - 16);
-
-		left_bitmap->Clear();
-		right_bitmap->Clear();
-
-		// Border Left
-		src_rect = { 32, 8, 8, 16 };
-		dst_rect = { 0, 0, 8, height - 16 };
-		left_bitmap->TiledBlit(0, 8, src_rect, *windowskin, dst_rect, 255);
-
-		// Border Right
-		src_rect = { 64 - 8, 8, 8, 16 };
-		dst_rect = { 0, 0, 8, height - 16 };
-		right_bitmap->TiledBlit(0, 8, src_rect, *windowskin, dst_rect, 255);
-
-		frame_left = left_bitmap;
-		frame_right = right_bitmap;
+		frame_left = GetSkinPart(*windowskin, SkinPart::FrameLeft, 8, height - 16, [&]() {
+			BitmapRef left_bitmap = Bitmap::Create(8, height - 16);
+			left_bitmap->Clear();
+
+			// Border Left
+			Rect src_rect = { 32, 8, 8, 16 };
+			Rect dst_rect = { 0, 0, 8, height - 16 };
+			left_bitmap->TiledBlit(0, 8, src_rect, *windowskin, dst_rect, 255);
+			return left_bitmap;
+		});
+
+		frame_right = GetSkinPart(*windowskin, SkinPart::FrameRight, 8, height - 16, [&]() {
+			BitmapRef right_bitmap = Bitmap::Create(8, height - 16);
+			right_bitmap->Clear();
+
+			// Border Right
+			Rect src_rect = { 64 - 8, 8, 8, 16 };
+			Rect dst_rect = { 0, 0, 8, height - 16 };
+			right_bitmap->TiledBlit(0, 8, src_rect, *windowskin, dst_rect, 255);
+			return right_bitmap;
+		});
 	} else {
 		frame_left = BitmapRef();
 		frame_right = BitmapRef();
@@ -237,57 +291,51 @@ void Window::RefreshCursor() {
 	int cw = cursor_rect.width;
 	int ch = cursor_rect.height;
 
-	BitmapRef cursor1_bitmap = Bitmap::Create(cw, ch);
-	BitmapRef cursor2_bitmap = Bitmap::Create(cw, ch);
+	// Both cursor animation frames are 32x32 cells next to each other,
+	// starting at sx in the windowskin
+	auto create_cursor = [&](int sx) {
+		BitmapRef cursor_bitmap = Bitmap::Create(cw, ch);
+		cursor_bitmap->Clear();
 
-	cursor1_bitmap->Clear();
-	cursor2_bitmap->Clear();
+		Rect dst_rect;
 
-	Rect dst_rect;
+		// Border Up
+		dst_rect = { 8, 0, cw - 16, 8 };
+		cursor_bitmap->TiledBlit(8, 0, Rect(sx + 8, 0, 16, 8), *windowskin, dst_rect, 255);
 
-	// Border Up
-	dst_rect = { 8, 0, cw - 16, 8 };
-	cursor1_bitmap->TiledBlit(8, 0, Rect(64 + 8, 0, 16, 8), *windowskin, dst_rect, 255);
-	cursor2_bitmap->TiledBlit(8, 0, Rect(96 + 8, 0, 16, 8), *windowskin, dst_rect, 255);
+		// Border Down
+		dst_rect = { 8, ch - 8, cw - 16, 8 };
+		cursor_bitmap->TiledBlit(8, 0, Rect(sx + 8, 32 - 8, 16, 8), *windowskin, dst_rect, 255);
 
-	// Border Down
-	dst_rect = { 8, ch - 8, cw - 16, 8 };
-	cursor1_bitmap->TiledBlit(8, 0, Rect(64 + 8, 32 - 8, 16, 8), *windowskin, dst_rect, 255);
-	cursor2_bitmap->TiledBlit(8, 0, Rect(96 + 8, 32 - 8, 16, 8), *windowskin, dst_rect, 255);
+		// Border Left
+		dst_rect = { 0, 8, 8, ch - 16 };
+		cursor_bitmap->TiledBlit(0, 8, Rect(sx, 8, 8, 16), *windowskin, dst_rect, 255);
 
-	// Border Left
-	dst_rect = { 0, 8, 8, ch - 16 };
-	cursor1_bitmap->TiledBlit(0, 8, Rect(64, 8, 8, 16), *windowskin, dst_rect, 255);
-	cursor2_bitmap->TiledBlit(0, 8, Rect(96, 8, 8, 16), *windowskin, dst_rect, 255);
+		// Border Right
+		dst_rect = { cw - 8, 8, 8, ch - 16 };
+		cursor_bitmap->TiledBlit(0, 8, Rect(sx + 32 - 8, 8, 8, 16), *windowskin, dst_rect, 255);
 
-	// Border Right
-	dst_rect = { cw - 8, 8, 8, ch - 16 };
-	cursor1_bitmap->TiledBlit(0, 8, Rect(96 - 8, 8, 8, 16), *windowskin, dst_rect, 255);
-	cursor2_bitmap->TiledBlit(0, 8, Rect(128 - 8, 8, 8, 16), *windowskin, dst_rect, 255);
+		// Upper left corner
+		cursor_bitmap->Blit(0, 0, *windowskin, Rect(sx, 0, 8, 8), 255);
 
-	// Upper left corner
-	cursor1_bitmap->Blit(0, 0, *windowskin, Rect(64, 0, 8, 8), 255);
-	cursor2_bitmap->Blit(0, 0, *windowskin, Rect(96, 0, 8, 8), 255);
+		// Upper right corner
+		cursor_bitmap->Blit(cw - 8, 0, *windowskin, Rect(sx + 32 - 8, 0, 8, 8), 255);
 
-	// Upper right corner
-	cursor1_bitmap->Blit(cw - 8, 0, *windowskin, Rect(96 - 8, 0, 8, 8), 255);
-	cursor2_bitmap->Blit(cw - 8, 0, *windowskin, Rect(128 - 8, 0, 8, 8), 255);
+		// Lower left corner
+		cursor_bitmap->Blit(0, ch - 8, *windowskin, Rect(sx, 32 - 8, 8, 8), 255);
 
-	// Lower left corner
-	cursor1_bitmap->Blit(0, ch - 8, *windowskin, Rect(64, 32 - 8, 8, 8), 255);
-	cursor2_bitmap->Blit(0, ch - 8, *windowskin, Rect(96, 32 - 8, 8, 8), 255);
+		// Lower right corner
+		cursor_bitmap->Blit(cw - 8, ch - 8, *windowskin, Rect(sx + 32 - 8, 32 - 8, 8, 8), 255);
 
-	// Lower right corner
-	cursor1_bitmap->Blit(cw - 8, ch - 8, *windowskin, Rect(96 - 8, 32 - 8, 8, 8), 255);
-	cursor2_bitmap->Blit(cw - 8, ch - 8, *windowskin, Rect(128 - 8, 32 - 8, 8, 8), 255);
+		// Background
+		dst_rect = { 8, 8, cw - 16, ch - 16 };
+		cursor_bitmap->TiledBlit(8, 8, Rect(sx + 8, 8, 16, 16), *windowskin, dst_rect, 255);
 
-	// Background
-	dst_rect = { 8, 8, cw - 16, ch - 16 };
-	cursor1_bitmap->TiledBlit(8, 8, Rect(64 + 8, 8, 16, 16), *windowskin, dst_rect, 255);
-	cursor2_bitmap->TiledBlit(8, 8, Rect(96 + 8, 8, 16, 16), *windowskin, dst_rect, 255);
+		return cursor_bitmap;
+	};
 
-	cursor1 = cursor1_bitmap;
-	cursor2 = cursor2_bitmap;
+	cursor1 = GetSkinPart(*windowskin, SkinPart::Cursor1, cw, ch, [&]() { return create_cursor(64); });
+	cursor2 = GetSkinPart(*windowskin, SkinPart::Cursor2, cw, ch, [&]() { return create_cursor(96); });
 }
 
 void Window::Update() {
@@ -22,6 +22,7 @@
 #include "game_party.h"
 #include "bitmap.h"
 #include "font.h"
+#include "player.h"
 
 Window_GameList::Window_GameList(int ix, int iy, int iwidth, int iheight) :
 	Window_Selectable(ix, iy, iwidth, iheight) {
@@ -30,32 +31,17 @@ Window_GameList::Window_GameList(int ix, int iy, int iwidth, int iheight) :
 
 void Window_GameList::Refresh() {
 	tree = FileFinder::CreateDirectoryTree(Main_Data::GetProjectPath());
-	game_directories.clear();
+	games.clear();
 
 	if (!tree) {
 		return;
 	}
 
-	// Find valid game diectories
-	for (auto& dir : *tree->ListDirectory()) {
-		if (dir.second.type != DirectoryTree::FileType::Directory) {
-			continue;
-		}
-
-		DirectoryTreeView subtree = tree->Subtree(dir.second.name);
-		if (FileFinder::IsValidProject(subtree)) {
-			game_directories.push_back(dir.second.name);
-		}
-	}
-
-	// Sort game list in place
-	std::sort(game_directories.begin(), game_directories.end(),
-			  [](const std::string& s, const std::string& s2) {
-				  return strcmp(Utils::LowerCase(s).c_str(), Utils::LowerCase(s2).c_str()) <= 0;
-			  });
+	// Find valid game directories
+	games = GameScanner::Scan(*tree, Player::game_list_cache_path);
 
 	if (HasValidGames()) {
-		item_max = game_directories.size();
+		item_max = games.size();
 
 		CreateContents();
 
@@ -76,13 +62,7 @@ void Window_GameList::DrawItem(int index) {
 	Rect rect = GetItemRect(index);
 	contents->ClearRect(rect);
 
-	std::string text;
-
-	if (HasValidGames()) {
-		text = game_directories[index];
-	}
-
-	contents->TextDraw(rect.x, rect.y, Font::ColorDefault, game_directories[index]);
+	contents->TextDraw(rect.x, rect.y, Font::ColorDefault, games[index].name);
 }
 
 void Window_GameList::DrawErrorText() {
@@ -117,9 +97,9 @@ void Window_GameList::DrawErrorText() {
 }
 
 bool Window_GameList::HasValidGames() {
-	return !game_directories.empty();
+	return !games.empty();
 }
 
 std::string Window_GameList::GetGamePath() {
-	return tree->MakePath(game_directories[GetIndex()]);
+	return tree->MakePath(games[GetIndex()].name);
 }
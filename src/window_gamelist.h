@@ -23,6 +23,7 @@
 #include "window_help.h"
 #include "window_selectable.h"
 #include "filefinder.h"
+#include "game_scanner.h"
 
 /**
  * Window_GameList class.
@@ -61,7 +62,7 @@ public:
 
 private:
 	std::unique_ptr<DirectoryTree> tree;
-	std::vector<std::string> game_directories;
+	std::vector<GameScanner::Game> games;
 };
 
 #endif
@@ -19,6 +19,7 @@
 #include "window_help.h"
 #include "bitmap.h"
 #include "font.h"
+#include "text.h"
 
 Window_Help::Window_Help(int ix, int iy, int iwidth, int iheight, Drawable::Flags flags) :
 	Window_Base(ix, iy, iwidth, iheight, flags),
@@ -57,13 +58,13 @@ void Window_Help::AddText(std::string text, int color, Text::Alignment align, bo
 		nextpos = text.find(' ', pos);
 		auto segment = ToStringView(text).substr(pos, nextpos - pos);
 		contents->TextDraw(text_x_offset, 2, color, segment, align);
-		text_x_offset += Font::Default()->GetSize(segment).width;
+		text_x_offset += Text::GetSize(*Font::Default(), segment).width;
 
 		if (nextpos != decltype(text)::npos) {
 			if (halfwidthspace) {
-				text_x_offset += Font::Default()->GetSize(" ").width / 2;
+				text_x_offset += Text::GetSize(*Font::Default(), " ").width / 2;
 			} else {
-				text_x_offset += Font::Default()->GetSize(" ").width;
+				text_x_offset += Text::GetSize(*Font::Default(), " ").width;
 			}
 			pos = nextpos + 1;
 		}
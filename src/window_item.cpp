@@ -29,6 +29,7 @@
 Window_Item::Window_Item(int ix, int iy, int iwidth, int iheight) :
 	Window_Selectable(ix, iy, iwidth, iheight) {
 	column_max = 2;
+	SetVirtualized(true);
 }
 
 const lcf::rpg::Item* Window_Item::GetItem() const {
@@ -94,13 +95,16 @@ void Window_Item::Refresh() {
 
 	CreateContents();
 
-	SetIndex(index);
-
 	contents->Clear();
 
-	for (int i = 0; i < item_max; ++i) {
-		DrawItem(i);
-	}
+	RefreshItems();
+
+	// After drawing, scrolling to the index only redraws when it leaves the held rows
+	SetIndex(index);
+}
+
+void Window_Item::RefreshItem(int index) {
+	DrawItem(index);
 }
 
 void Window_Item::DrawItem(int index) {
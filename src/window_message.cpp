@@ -126,6 +126,8 @@ Window_Message::~Window_Message() {
 
 void Window_Message::StartMessageProcessing(PendingMessage pm) {
 	text.clear();
+	tokens.clear();
+	token_index = 0;
 	pending_message = std::move(pm);
 
 	if (!IsVisible()) {
@@ -178,10 +180,10 @@ void Window_Message::StartMessageProcessing(PendingMessage pm) {
 
 	item_max = min(4, pending_message.GetNumChoices());
 
-	text_index = text.data();
-
 	DebugLog("%d: MSG TEXT \n%s", text.c_str());
 
+	LayoutMessage();
+
 	auto open_frames = (!IsVisible() && !Game_Battle::IsBattleRunning()) ? message_animation_frames : 0;
 	SetOpenAnimation(open_frames);
 	DebugLog("{}: MSG START OPEN {}", open_frames);
@@ -189,6 +191,66 @@ void Window_Message::StartMessageProcessing(PendingMessage pm) {
 	InsertNewPage();
 }
 
+void Window_Message::LayoutMessage() {
+	tokens.clear();
+	token_index = 0;
+
+	auto font = Font::Default();
+	const auto* begin = text.data();
+	const auto* iter = begin;
+	const auto* end = begin + text.size();
+
+	while (iter != end) {
+		auto tret = Utils::TextNext(iter, end, Player::escape_char);
+		iter = tret.next;
+
+		MessageToken token;
+		const auto ch = tret.ch;
+		token.ch = ch;
+		token.param = static_cast<uint32_t>(iter - begin);
+
+		if (EP_UNLIKELY(!tret)) {
+			token.type = MessageToken::Type::None;
+		} else if (tret.is_exfont) {
+			token.type = MessageToken::Type::ExFont;
+			token.value = Font::exfont->GetSize(ch).width;
+		} else if (ch == '\f') {
+			token.type = MessageToken::Type::NewPage;
+		} else if (ch == '\n') {
+			token.type = MessageToken::Type::NewLine;
+		} else if (Utils::IsControlCharacter(ch)) {
+			// control characters not handled
+			token.type = MessageToken::Type::None;
+		} else if (tret.is_escape && ch != Player::escape_char) {
+			// Special message codes, the parameters are only skipped here.
+			// They can reference variables and are evaluated when typing reaches them.
+			token.type = MessageToken::Type::Command;
+			switch (ch) {
+			case 'c':
+			case 'C':
+				iter = Game_Message::ParseColor(iter, end, Player::escape_char, true).next;
+				break;
+			case 's':
+			case 'S':
+				iter = Game_Message::ParseSpeed(iter, end, Player::escape_char, true).next;
+				break;
+			case '_':
+				// Half size space
+				token.value = font->GetSize(" ").width / 2;
+				break;
+			default:
+				break;
+			}
+		} else {
+			token.type = MessageToken::Type::Glyph;
+			token.value = font->GetSize(ch).width;
+		}
+
+		token.next = static_cast<uint32_t>(iter - begin);
+		tokens.push_back(token);
+	}
+}
+
 void Window_Message::OnFinishPage() {
 	DebugLog("{}: FINISH PAGE");
 
@@ -296,8 +358,9 @@ void Window_Message::InsertNewPage() {
 		ShowGoldWindow();
 	} else {
 		// If first character is gold, the gold window appears immediately and animates open with the main window.
-		auto tret = Utils::TextNext(text_index, (text.data() + text.size()), Player::escape_char);
-		if (tret && tret.is_escape && tret.ch == '$') {
+		if (token_index < tokens.size()
+				&& tokens[token_index].type == MessageToken::Type::Command
+				&& tokens[token_index].ch == '$') {
 			ShowGoldWindow();
 		}
 	}
@@ -336,7 +399,8 @@ void Window_Message::InsertNewLine() {
 void Window_Message::FinishMessageProcessing() {
 	DebugLog("{}: FINISH MSG");
 	text.clear();
-	text_index = text.data();
+	tokens.clear();
+	token_index = 0;
 
 	SetPause(false);
 	kill_page = false;
@@ -445,8 +509,6 @@ void Window_Message::UpdateMessage() {
 	auto font = Font::Default();
 
 	while (true) {
-		const auto* end = text.data() + text.size();
-
 		if (wait_count > 0) {
 			DebugLog("{}: MSG WAIT LOOP {}", wait_count);
 			--wait_count;
@@ -457,38 +519,35 @@ void Window_Message::UpdateMessage() {
 			break;
 		}
 
-		if (text_index == end) {
+		if (token_index == tokens.size()) {
 			FinishMessageProcessing();
 			break;
 		}
 
-		auto tret = Utils::TextNext(text_index, end, Player::escape_char);
-		auto text_prev = text_index;
-		text_index = tret.next;
+		const auto& token = tokens[token_index++];
 
-		if (EP_UNLIKELY(!tret)) {
+		if (token.type == MessageToken::Type::None) {
 			continue;
 		}
 
-		const auto ch = tret.ch;
-		if (tret.is_exfont) {
-			if (!DrawGlyph(*font, *system, ch, true)) {
-				text_index = text_prev;
+		if (token.type == MessageToken::Type::ExFont) {
+			if (!DrawGlyph(*font, *system, token)) {
+				--token_index;
 			}
 			continue;
 		}
 
-		if (ch == '\f') {
-			if (text_index != end) {
+		if (token.type == MessageToken::Type::NewPage) {
+			if (token_index != tokens.size()) {
 				InsertNewPage();
 				SetWait(1);
 			}
 			continue;
 		}
 
-		if (ch == '\n') {
+		if (token.type == MessageToken::Type::NewLine) {
 			int wait_frames = 0;
-			bool end_page = (*text_index == '\f');
+			bool end_page = (token_index < tokens.size() && tokens[token_index].type == MessageToken::Type::NewPage);
 
 			if (!instant_speed) {
 				if (!prev_char_printable) {
@@ -514,21 +573,14 @@ void Window_Message::UpdateMessage() {
 			continue;
 		}
 
-		if (Utils::IsControlCharacter(ch)) {
-			// control characters not handled
-			continue;
-		}
-
-		if (tret.is_escape && ch != Player::escape_char) {
+		if (token.type == MessageToken::Type::Command) {
 			// Special message codes
-			switch (ch) {
+			switch (token.ch) {
 			case 'c':
 			case 'C':
 				{
 					// Color
-					auto pres = Game_Message::ParseColor(text_index, end, Player::escape_char, true);
-					auto value = pres.value;
-					text_index = pres.next;
+					auto value = Game_Message::ParseColor(text.data() + token.param, text.data() + token.next, Player::escape_char, true).value;
 					DebugLogText("{}: MSG Color \\c[{}]", value);
 					SetWaitForNonPrintable(0);
 					text_color = value > 19 ? 0 : value;
@@ -538,16 +590,15 @@ void Window_Message::UpdateMessage() {
 			case 'S':
 				{
 					// Speed modifier
-					auto pres = Game_Message::ParseSpeed(text_index, end, Player::escape_char, true);
-					text_index = pres.next;
-					DebugLogText("{}: MSG Speed \\s[{}]", pres.value);
+					auto value = Game_Message::ParseSpeed(text.data() + token.param, text.data() + token.next, Player::escape_char, true).value;
+					DebugLogText("{}: MSG Speed \\s[{}]", value);
 					SetWaitForNonPrintable(0);
-					speed = Utils::Clamp(pres.value, 1, 20);
+					speed = Utils::Clamp(value, 1, 20);
 				}
 				break;
 			case '_':
 				// Insert half size space
-				contents_x += Font::Default()->GetSize(" ").width / 2;
+				contents_x += token.value;
 				DebugLogText("{}: MSG HalfWait \\_");
 				SetWaitForCharacter(1);
 				break;
@@ -605,14 +656,17 @@ void Window_Message::UpdateMessage() {
 			continue;
 		}
 
-		if (!DrawGlyph(*font, *system, ch, false)) {
-			text_index = text_prev;
+		if (!DrawGlyph(*font, *system, token)) {
+			--token_index;
 			continue;
 		}
 	}
 }
 
-bool Window_Message::DrawGlyph(Font& font, const Bitmap& system, char32_t glyph, bool is_exfont) {
+bool Window_Message::DrawGlyph(Font& font, const Bitmap& system, const MessageToken& token) {
+	const bool is_exfont = (token.type == MessageToken::Type::ExFont);
+	const char32_t glyph = token.ch;
+
 	if (is_exfont) {
 		DebugLogText("{}: MSG DrawGlyph Exfont {}", static_cast<uint32_t>(glyph));
 	} else {
@@ -631,9 +685,7 @@ bool Window_Message::DrawGlyph(Font& font, const Bitmap& system, char32_t glyph,
 
 	// Wide characters cause an extra wait if the last printed character did not wait.
 	if (prev_char_printable && !prev_char_waited) {
-		auto& wide_font = is_exfont ? *Font::exfont : font;
-		auto rect = wide_font.GetSize(glyph);
-		auto width = get_width(rect.width);
+		auto width = get_width(token.value);
 		if (width >= 2) {
 			prev_char_waited = true;
 			++line_char_counter;
@@ -748,7 +800,9 @@ void Window_Message::SetWaitForNonPrintable(int frames) {
 void Window_Message::SetWaitForCharacter(int width) {
 	int frames = 0;
 	if (!instant_speed && width > 0) {
-		bool is_last_for_page = (text.data() + text.size() - text_index) < 2 || (*text_index == '\n' && *(text_index + 1) == '\f');
+		// The look-ahead works on the bytes behind the current character, like RPG_RT
+		const auto* next = text.data() + tokens[token_index - 1].next;
+		bool is_last_for_page = (text.data() + text.size() - next) < 2 || (*next == '\n' && *(next + 1) == '\f');
 
 		if (is_last_for_page) {
 			// RPG_RT always waits 2 frames for last character on the page.
@@ -760,7 +814,7 @@ void Window_Message::SetWaitForCharacter(int width) {
 			} else {
 				frames = width / 2;
 				if (width & 1) {
-					bool is_last_for_line = (*text_index == '\n');
+					bool is_last_for_line = (*next == '\n');
 
 					// RPG_RT waits for every even character. Also always waits
 					// for the last character.
@@ -20,6 +20,7 @@
 
 // Headers
 #include <string>
+#include <vector>
 #include "window_gold.h"
 #include "window_numberinput.h"
 #include "window_selectable.h"
@@ -90,8 +91,8 @@ public:
 	void Update() override;
 
 	/**
-	 * Continues outputting more text. Also handles the
-	 * CommandCode parsing.
+	 * Continues outputting more text by replaying the tokens
+	 * created by LayoutMessage.
 	 */
 	virtual void UpdateMessage();
 
@@ -139,6 +140,41 @@ public:
 	void SetMaxLinesPerPage(int lines);
 
 protected:
+	/** Element of the message text, created once per message by LayoutMessage */
+	struct MessageToken {
+		enum class Type : uint8_t {
+			/** Invalid or unhandled control character, skipped */
+			None,
+			/** Printable character */
+			Glyph,
+			/** Exfont character */
+			ExFont,
+			/** Line break */
+			NewLine,
+			/** Page break */
+			NewPage,
+			/** Message code (\C, \S, \$, ...) */
+			Command
+		};
+
+		Type type = Type::None;
+		/** Character, exfont index or message code */
+		char32_t ch = 0;
+		/** Glyph width or the width of \_ */
+		int value = 0;
+		/** Offset in text behind the character, where parameters of \C and \S start */
+		uint32_t param = 0;
+		/** Offset in text behind the token */
+		uint32_t next = 0;
+	};
+
+	/**
+	 * Splits text into tokens. Glyphs are measured here instead of every
+	 * frame while typing. Parameters of message codes can reference
+	 * variables and are only evaluated when typing reaches them.
+	 */
+	void LayoutMessage();
+
 	/** Async operation */
 	AsyncOp aop;
 	/** X-position of next char. */
@@ -149,10 +185,12 @@ protected:
 	int line_count = 0;
 	/** Maximum number of lines per page */
 	int max_lines_per_page = 4;
-	/** Index of the next char in text that will be output. */
-	const char* text_index = nullptr;
 	/** text message that will be displayed. */
 	std::string text;
+	/** Parsed message that will be displayed. */
+	std::vector<MessageToken> tokens;
+	/** Index of the next token that will be output. */
+	size_t token_index = 0;
 	/** Text color. */
 	int text_color = 0;
 	/** Current speed modifier. */
@@ -186,7 +224,7 @@ protected:
 
 	PendingMessage pending_message;
 
-	bool DrawGlyph(Font& font, const Bitmap& system, char32_t glyph, bool is_exfont);
+	bool DrawGlyph(Font& font, const Bitmap& system, const MessageToken& token);
 	void IncrementLineCharCounter(int width);
 
 	void SetWaitForCharacter(int width);
@@ -29,7 +29,19 @@ Window_Selectable::Window_Selectable(int ix, int iy, int iwidth, int iheight) :
 	Window_Base(ix, iy, iwidth, iheight) { }
 
 void Window_Selectable::CreateContents() {
-	SetContents(Bitmap::Create(width - 16, max(height - 16, GetRowMax() * 16)));
+	int top_row = GetTopRow();
+	int rows = GetRowMax();
+
+	if (virtualized && rows > GetContentsRowMax()) {
+		rows = GetContentsRowMax();
+		SetContents(Bitmap::Create(width - 16, max(height - 16, rows * 16)));
+		contents_row_first = ClampContentsRowFirst(top_row - GetPageRowMax());
+	} else {
+		SetContents(Bitmap::Create(width - 16, max(height - 16, rows * 16)));
+		contents_row_first = 0;
+	}
+
+	SetOy((top_row - contents_row_first) * 16);
 }
 
 // Properties
@@ -48,12 +60,22 @@ int Window_Selectable::GetRowMax() const {
 	return (item_max + column_max - 1) / column_max;
 }
 int Window_Selectable::GetTopRow() const {
-	return oy / 16;
+	return contents_row_first + oy / 16;
 }
 void Window_Selectable::SetTopRow(int row) {
 	if (row < 0) row = 0;
 	if (row > GetRowMax() - 1) row = GetRowMax() - 1;
-	SetOy(row * 16);
+
+	if (virtualized && contents) {
+		int contents_rows = contents->GetHeight() / 16;
+		if (row < contents_row_first || row + GetPageRowMax() > contents_row_first + contents_rows) {
+			contents_row_first = ClampContentsRowFirst(row - GetPageRowMax());
+			contents->Clear();
+			RefreshItems();
+		}
+	}
+
+	SetOy((row - contents_row_first) * 16);
 }
 int Window_Selectable::GetPageRowMax() const {
 	return (height - 16) / 16;
@@ -67,10 +89,43 @@ Rect Window_Selectable::GetItemRect(int index) {
 	rect.width = (width / column_max - 16);
 	rect.x = (index % column_max * (rect.width + 16));
 	rect.height = 12;
-	rect.y = index / column_max * 16 + 2;
+	rect.y = (index / column_max - contents_row_first) * 16 + 2;
 	return rect;
 }
 
+void Window_Selectable::SetVirtualized(bool state) {
+	virtualized = state;
+}
+
+int Window_Selectable::GetContentsRowMax() const {
+	return GetPageRowMax() * 3;
+}
+
+int Window_Selectable::ClampContentsRowFirst(int row) const {
+	int contents_rows = contents ? contents->GetHeight() / 16 : GetRowMax();
+	return max(0, min(row, GetRowMax() - contents_rows));
+}
+
+int Window_Selectable::GetContentsItemFirst() const {
+	return min(contents_row_first * column_max, item_max);
+}
+
+int Window_Selectable::GetContentsItemEnd() const {
+	if (!contents) {
+		return item_max;
+	}
+	return min((contents_row_first + contents->GetHeight() / 16) * column_max, item_max);
+}
+
+void Window_Selectable::RefreshItem(int) {
+}
+
+void Window_Selectable::RefreshItems() {
+	for (int i = GetContentsItemFirst(); i < GetContentsItemEnd(); ++i) {
+		RefreshItem(i);
+	}
+}
+
 Window_Help* Window_Selectable::GetHelpWindow() {
 	return help_window;
 }
@@ -106,7 +161,7 @@ void Window_Selectable::UpdateCursorRect() {
 	cursor_width = (width / column_max - 16) + 8;
 	x = (index % column_max * (cursor_width + 8)) - 4;
 
-	int y = index / column_max * 16 - oy;
+	int y = (row - contents_row_first) * 16 - oy;
 	SetCursorRect(Rect(x, y, cursor_width, 16));
 }
 
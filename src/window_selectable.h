@@ -80,9 +80,39 @@ public:
 	 */
 	void SetEndlessScrolling(bool state);
 
+	/**
+	 * Enables virtualized drawing for long lists.
+	 * The contents only hold the visible rows and a margin of one page
+	 * above and below. When scrolling out of these rows the held rows are
+	 * moved and redrawn through RefreshItem.
+	 *
+	 * @param state true to enable, false to disable (default).
+	 */
+	void SetVirtualized(bool state);
+
 protected:
 	void UpdateArrows();
 
+	/**
+	 * Redraws a single item.
+	 * Called for every row held by the contents when the contents are
+	 * moved in virtualized mode.
+	 *
+	 * @param index index of item.
+	 */
+	virtual void RefreshItem(int index);
+
+	/**
+	 * Redraws all items held by the contents through RefreshItem.
+	 */
+	void RefreshItems();
+
+	/** @return index of the first item held by the contents */
+	int GetContentsItemFirst() const;
+
+	/** @return index after the last item held by the contents */
+	int GetContentsItemEnd() const;
+
 	Window_Help* help_window = nullptr;
 	int item_max = 1;
 	int column_max = 1;
@@ -90,6 +120,14 @@ protected:
 	int arrow_frame = 0;
 
 	bool endless_scrolling = true;
+
+private:
+	int GetContentsRowMax() const;
+	int ClampContentsRowFirst(int row) const;
+
+	bool virtualized = false;
+	/** First row of the list which is held by the contents */
+	int contents_row_first = 0;
 };
 
 #endif
@@ -59,6 +59,13 @@ public:
 	 */
 	void DrawItem(int index);
 
+	/**
+	 * Redraws an item when the contents are moved.
+	 *
+	 * @param index index of item to draw.
+	 */
+	void RefreshItem(int index) override;
+
 	/**
 	 * Updates the help window.
 	 */
@@ -0,0 +1,76 @@
+#include <cmath>
+#include <vector>
+#include "audio_resampler_sinc.h"
+#include "doctest.h"
+
+static constexpr double pi = 3.14159265358979323846;
+
+static std::vector<float> Resample(SincResampler& r, const std::vector<float>& in, int channels) {
+	std::vector<float> out;
+	std::vector<float> buf(64 * channels);
+	size_t pos = 0;
+	for (;;) {
+		uint32_t in_frames = static_cast<uint32_t>(std::min<size_t>(100, in.size() / channels - pos));
+		uint32_t out_frames = 64;
+		bool end_of_input = (pos + in_frames == in.size() / channels);
+		r.Process(in.data() + pos * channels, in_frames, buf.data(), out_frames, end_of_input);
+		pos += in_frames;
+		out.insert(out.end(), buf.begin(), buf.begin() + out_frames * channels);
+		if (in_frames == 0 && out_frames == 0) {
+			break;
+		}
+	}
+	return out;
+}
+
+TEST_SUITE_BEGIN("SincResampler");
+
+TEST_CASE("DC") {
+	for (auto q: { SincResampler::Quality::Low, SincResampler::Quality::Medium, SincResampler::Quality::High }) {
+		SincResampler r(2, q);
+		r.SetRate(22050, 44100);
+
+		std::vector<float> in(2 * 4000, 0.5f);
+		auto out = Resample(r, in, 2);
+
+		// The end of the input is flushed
+		REQUIRE_EQ(out.size(), 2 * 8000);
+		// Skip the filter warm-up
+		for (size_t i = 2 * 64; i < out.size() - 2 * 64; ++i) {
+			REQUIRE_LT(std::fabs(out[i] - 0.5f), 0.001f);
+		}
+	}
+}
+
+TEST_CASE("Sine") {
+	SincResampler r(1, SincResampler::Quality::High);
+	r.SetRate(44100, 48000);
+
+	std::vector<float> in(44100);
+	for (size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<float>(std::sin(2.0 * pi * 440.0 * i / 44100.0));
+	}
+	auto out = Resample(r, in, 1);
+
+	REQUIRE_GE(out.size(), 47999);
+	REQUIRE_LE(out.size(), 48001);
+	for (size_t i = 64; i < out.size() - 64; ++i) {
+		REQUIRE_LT(std::fabs(out[i] - std::sin(2.0 * pi * 440.0 * i / 48000.0)), 0.001);
+	}
+}
+
+TEST_CASE("RateChange") {
+	SincResampler r(1, SincResampler::Quality::Low);
+	std::vector<float> in(1000, 1.0f);
+
+	r.SetRate(2, 1);
+	auto out = Resample(r, in, 1);
+	REQUIRE_EQ(out.size(), 500);
+
+	r.Reset();
+	r.SetRate(1, 2);
+	out = Resample(r, in, 1);
+	REQUIRE_EQ(out.size(), 2000);
+}
+
+TEST_SUITE_END();
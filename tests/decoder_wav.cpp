@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "decoder_wav.h"
+#include "filefinder.h"
+#include "doctest.h"
+
+#ifdef WANT_FASTWAV
+
+namespace {
+	void Write16(std::ofstream& os, uint16_t val) {
+		os.put(static_cast<char>(val & 0xFF));
+		os.put(static_cast<char>(val >> 8));
+	}
+
+	void Write32(std::ofstream& os, uint32_t val) {
+		Write16(os, static_cast<uint16_t>(val & 0xFFFF));
+		Write16(os, static_cast<uint16_t>(val >> 16));
+	}
+
+	/** Writes a mono 8 bit PCM wav file, data_size can claim more data than written */
+	void WriteWav(const std::string& path, const std::vector<uint8_t>& samples, uint32_t data_size) {
+		std::ofstream os(path, std::ios::binary | std::ios::trunc);
+		os.write("RIFF", 4);
+		Write32(os, 36 + data_size);
+		os.write("WAVEfmt ", 8);
+		Write32(os, 16);
+		Write16(os, 1);
+		Write16(os, 1);
+		Write32(os, 22050);
+		Write32(os, 22050);
+		Write16(os, 1);
+		Write16(os, 8);
+		os.write("data", 4);
+		Write32(os, data_size);
+		os.write(reinterpret_cast<const char*>(samples.data()), samples.size());
+	}
+
+	std::vector<uint8_t> MakeSamples() {
+		std::vector<uint8_t> samples(10000);
+		for (size_t i = 0; i < samples.size(); ++i) {
+			samples[i] = static_cast<uint8_t>(i * 7);
+		}
+		return samples;
+	}
+
+	const std::string wav_path = "decoder_wav_test.wav";
+}
+
+TEST_SUITE_BEGIN("WavDecoder");
+
+TEST_CASE("Mapped") {
+	auto samples = MakeSamples();
+	WriteWav(wav_path, samples, samples.size());
+
+	WavDecoder streamed;
+	REQUIRE(streamed.Open(FileFinder::OpenInputStream(wav_path)));
+	WavDecoder mapped(wav_path);
+	REQUIRE(mapped.Open(FileFinder::OpenInputStream(wav_path)));
+
+	int frequency;
+	AudioDecoder::Format format;
+	int channels;
+	mapped.GetFormat(frequency, format, channels);
+	CHECK(frequency == 22050);
+	CHECK(format == AudioDecoder::Format::U8);
+	CHECK(channels == 1);
+
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	CHECK(!streamed.GetSampleData(data, size));
+
+	auto owner = mapped.GetSampleData(data, size);
+	if (owner) {
+		REQUIRE(size == samples.size());
+		CHECK(std::equal(samples.begin(), samples.end(), data));
+	}
+
+	CHECK(streamed.DecodeAll() == samples);
+	CHECK(mapped.DecodeAll() == samples);
+	CHECK(mapped.IsFinished());
+
+	std::vector<uint8_t> buffer(100);
+	REQUIRE(mapped.Seek(5000, std::ios_base::beg));
+	CHECK(!mapped.IsFinished());
+	CHECK(mapped.Decode(buffer.data(), buffer.size()) == 100);
+	CHECK(std::equal(buffer.begin(), buffer.end(), samples.begin() + 5000));
+
+	std::remove(wav_path.c_str());
+}
+
+TEST_CASE("Truncated") {
+	// The data chunk claims more samples than the file contains
+	auto samples = MakeSamples();
+	WriteWav(wav_path, samples, samples.size() * 2);
+
+	WavDecoder mapped(wav_path);
+	REQUIRE(mapped.Open(FileFinder::OpenInputStream(wav_path)));
+
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	if (mapped.GetSampleData(data, size)) {
+		CHECK(size == samples.size());
+	}
+	CHECK(mapped.DecodeAll() == samples);
+
+	std::remove(wav_path.c_str());
+}
+
+TEST_SUITE_END();
+
+#endif
@@ -3,6 +3,7 @@
 #include "main_data.h"
 #include "doctest.h"
 #include "player.h"
+#include <sstream>
 
 static bool skip_tests() {
 #ifdef EMSCRIPTEN
@@ -102,4 +103,26 @@ TEST_CASE("FindFile") {
 	Player::escape_symbol = "";
 }
 
+TEST_CASE("Index") {
+	auto tree = DirectoryTree::Create(EP_TEST_PATH "/game");
+	tree->ListDirectory();
+	tree->ListDirectory("Charset");
+
+	std::stringstream ss;
+	REQUIRE(tree->WriteIndex(ss));
+
+	auto indexed_tree = DirectoryTree::Create(EP_TEST_PATH "/game");
+	CHECK(indexed_tree->ReadIndex(ss) == 2);
+
+	auto root = indexed_tree->ListDirectory();
+	CHECK(root->size() == 4);
+	CHECK(root->find("charset")->second.type == DirectoryTree::FileType::Directory);
+	CHECK(indexed_tree->FindFile("cHaRsEt", "chara1.png") == tree->FindFile("Charset", "chara1.png"));
+
+	// Index of a different tree is ignored
+	std::stringstream ss2(ss.str());
+	auto other_tree = DirectoryTree::Create(EP_TEST_PATH);
+	CHECK(other_tree->ReadIndex(ss2) == 0);
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,42 @@
+#include <fstream>
+#include <sstream>
+#include "file_hash.h"
+#include "filefinder.h"
+#include "utils.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("FileHash");
+
+TEST_CASE("CRC32") {
+	std::ifstream ref(EP_TEST_PATH "/platform/1kb", std::ios::binary);
+	uint32_t expected = Utils::CRC32(ref);
+
+	auto is = FileFinder::OpenInputStream(EP_TEST_PATH "/platform/1kb");
+	REQUIRE(is);
+	CHECK(FileHash::CRC32(is) == expected);
+
+	std::stringstream ss("123456789");
+	CHECK(FileHash::CRC32(ss) == 0xCBF43926);
+}
+
+TEST_CASE("GetCRC32") {
+	std::ifstream ref(EP_TEST_PATH "/platform/1kb", std::ios::binary);
+	uint32_t expected = Utils::CRC32(ref);
+
+	FileHash::Prefetch(EP_TEST_PATH "/platform/1kb");
+
+	uint32_t crc = 0;
+	CHECK(FileHash::GetCRC32(EP_TEST_PATH "/platform/1kb", crc));
+	CHECK(crc == expected);
+
+	// Cached
+	crc = 0;
+	CHECK(FileHash::GetCRC32(EP_TEST_PATH "/platform/1kb", crc));
+	CHECK(crc == expected);
+
+	CHECK(!FileHash::GetCRC32(EP_TEST_PATH "/notafile", crc));
+
+	FileHash::Clear();
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,143 @@
+#include "filesystem_archive.h"
+#include "filefinder.h"
+#include "doctest.h"
+#include <iterator>
+#include <sstream>
+
+static bool skip_tests() {
+#ifdef EMSCRIPTEN
+	return true;
+#else
+	return false;
+#endif
+}
+
+static std::shared_ptr<ArchiveFilesystem> PackTestGame() {
+	std::stringstream ss;
+	REQUIRE(ArchiveFilesystem::Pack(EP_TEST_PATH "/game", ss));
+
+	auto data = std::make_shared<std::string>(ss.str());
+	auto* ptr = reinterpret_cast<const uint8_t*>(data->data());
+	size_t size = data->size();
+	return ArchiveFilesystem::Create(std::move(data), ptr, size);
+}
+
+static std::string ReadAll(std::istream& is) {
+	return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+TEST_SUITE_BEGIN("ArchiveFilesystem" * doctest::skip(skip_tests()));
+
+TEST_CASE("Invalid") {
+	std::string data = "not an archive, just some text";
+	CHECK(!ArchiveFilesystem::Create(nullptr, reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+}
+
+TEST_CASE("CorruptSize") {
+	std::stringstream ss;
+	REQUIRE(ArchiveFilesystem::Pack(EP_TEST_PATH "/game", ss));
+	auto data = ss.str();
+
+	auto read_u64 = [&](size_t pos) {
+		uint64_t value = 0;
+		for (int i = 0; i < 8; ++i) {
+			value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (i * 8);
+		}
+		return value;
+	};
+
+	// Claim a huge uncompressed size for the first file
+	size_t pos = static_cast<size_t>(read_u64(16));
+	size_t name_len = static_cast<uint8_t>(data[pos]) | (static_cast<uint8_t>(data[pos + 1]) << 8);
+	size_t flags_pos = pos + 2 + name_len;
+	size_t size_pos = flags_pos + 1 + 8;
+	REQUIRE(size_pos + 8 <= data.size());
+	data[flags_pos] = 1;
+	for (int i = 0; i < 8; ++i) {
+		data[size_pos + i] = static_cast<char>(0xFF);
+	}
+
+	CHECK(!ArchiveFilesystem::Create(nullptr, reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+}
+
+TEST_CASE("FindEntry") {
+	auto archive = PackTestGame();
+	REQUIRE(archive);
+	CHECK(archive->GetEntries().size() == 4);
+
+	auto* entry = archive->FindEntry("charset/CHARA1.PNG");
+	REQUIRE(entry);
+	CHECK(entry->name == "Charset/chara1.png");
+	// Already compressed formats are stored
+	CHECK(!entry->compressed);
+	CHECK(entry->size == entry->stored_size);
+
+	CHECK(archive->FindEntry("rpg_rt.ldb"));
+	CHECK(!archive->FindEntry("Charset"));
+	CHECK(!archive->FindEntry("!!!invalidpath!!!"));
+}
+
+TEST_CASE("ListDirectory") {
+	auto archive = PackTestGame();
+	REQUIRE(archive);
+
+	std::vector<DirectoryTree::Entry> entries;
+	REQUIRE(archive->ListDirectory("", entries));
+	CHECK(entries.size() == 4);
+	for (const auto& entry: entries) {
+		if (entry.name == "Charset") {
+			CHECK(entry.type == DirectoryTree::FileType::Directory);
+		} else {
+			CHECK(entry.type == DirectoryTree::FileType::Regular);
+		}
+	}
+
+	REQUIRE(archive->ListDirectory("CHARSET", entries));
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].name == "chara1.png");
+
+	CHECK(!archive->ListDirectory("!!!invalidpath!!!", entries));
+}
+
+TEST_CASE("OpenInputStream") {
+	auto archive = PackTestGame();
+	REQUIRE(archive);
+
+	for (const auto& entry: archive->GetEntries()) {
+		auto is = archive->OpenInputStream(entry.name);
+		REQUIRE(is);
+		auto fs = FileFinder::OpenInputStream(FileFinder::MakePath(EP_TEST_PATH "/game", entry.name), std::ios_base::in | std::ios_base::binary);
+		REQUIRE(fs);
+		CHECK(ReadAll(is) == ReadAll(fs));
+	}
+
+	auto is = archive->OpenInputStream("RPG_RT.ldb");
+	REQUIRE(is);
+	is.seekg(0, std::ios_base::end);
+	CHECK(static_cast<uint64_t>(is.tellg()) == archive->FindEntry("RPG_RT.ldb")->size);
+	is.seekg(0);
+	CHECK(is.get() != EOF);
+
+	CHECK(!archive->OpenInputStream("!!!invalidpath!!!"));
+}
+
+TEST_CASE("Mount") {
+	auto archive = PackTestGame();
+	REQUIRE(archive);
+
+	ArchiveFilesystem::Mount("game.easyrpg", archive);
+
+	// Uses the native path separator
+	Filesystem_Stream::InputStream is;
+	CHECK(ArchiveFilesystem::OpenMounted(FileFinder::MakePath("game.easyrpg", FileFinder::MakePath("Charset", "chara1.png")), is));
+	CHECK(is);
+	CHECK(archive->FindEntry(FileFinder::MakePath("Charset", "chara1.png")));
+
+	CHECK(!ArchiveFilesystem::OpenMounted("game.easyrpgx/RPG_RT.ldb", is));
+	CHECK(!ArchiveFilesystem::OpenMounted("other/RPG_RT.ldb", is));
+
+	ArchiveFilesystem::UnmountAll();
+	CHECK(!ArchiveFilesystem::OpenMounted("game.easyrpg/RPG_RT.ldb", is));
+}
+
+TEST_SUITE_END();
@@ -59,7 +59,9 @@ TEST_CASE("FontGlyphChar") {
 	auto check = [&](char32_t ch, Rect r) {
 		auto ret = font->Glyph(ch);
 		REQUIRE(ret.bitmap != nullptr);
-		REQUIRE_EQ(ret.rect, r);
+		// Glyphs are located somewhere in the glyph atlas
+		REQUIRE_EQ(ret.rect.width, r.width);
+		REQUIRE_EQ(ret.rect.height, r.height);
 	};
 
 	check(0, Rect(0, 0, 0, ch));
@@ -111,4 +113,30 @@ TEST_CASE("FontGlyphCharEx") {
 	}
 }
 
+TEST_CASE("FontGlyphAtlas") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto font = Font::Default();
+
+	auto x = font->Glyph(U'X');
+	auto y = font->Glyph(U'Y');
+	auto x2 = font->Glyph(U'X');
+
+	REQUIRE_EQ(x.bitmap, y.bitmap);
+	REQUIRE_EQ(x.bitmap, x2.bitmap);
+	REQUIRE_EQ(x.rect, x2.rect);
+	REQUIRE_NE(x.rect, y.rect);
+}
+
+TEST_CASE("FontGlyphExShared") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto font = Font::exfont;
+	auto exfont = Cache::Exfont();
+
+	for (char32_t i = 0; i < 52; ++i) {
+		auto ret = font->Glyph(i);
+		REQUIRE_EQ(ret.bitmap, exfont);
+		REQUIRE_EQ(ret.rect, Rect((i % 13) * cwf, (i / 13) * cwf, cwf, cwf));
+	}
+}
+
 TEST_SUITE_END();
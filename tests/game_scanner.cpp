@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <sstream>
+#include "game_scanner.h"
+#include "filefinder.h"
+#include "main_data.h"
+#include "doctest.h"
+
+static bool skip_tests() {
+#ifdef EMSCRIPTEN
+	return true;
+#else
+	return false;
+#endif
+}
+
+TEST_SUITE_BEGIN("GameScanner" * doctest::skip(skip_tests()));
+
+TEST_CASE("Probe") {
+	CHECK(GameScanner::Probe(EP_TEST_PATH "/game") == GameScanner::ProjectType::RPG2k);
+	CHECK(GameScanner::Probe(EP_TEST_PATH "/notagame") == GameScanner::ProjectType::None);
+	CHECK(GameScanner::Probe(EP_TEST_PATH "/notafolder") == GameScanner::ProjectType::None);
+}
+
+TEST_CASE("Scan") {
+	Main_Data::Init();
+
+	auto tree = FileFinder::CreateDirectoryTree(EP_TEST_PATH);
+	REQUIRE(tree);
+
+	auto games = GameScanner::Scan(*tree, "");
+	auto has_game = [&](const char* name) {
+		return std::any_of(games.begin(), games.end(), [&](const GameScanner::Game& game) {
+			return game.name == name;
+		});
+	};
+	CHECK(has_game("game"));
+	CHECK(!has_game("notagame"));
+	CHECK(!has_game("platform"));
+}
+
+TEST_CASE("Cache") {
+	std::vector<GameScanner::Game> games(3);
+	games[0].name = "game";
+	games[0].type = GameScanner::ProjectType::EasyRpg;
+	games[0].mtime = 100;
+	games[1].name = "not a game";
+	games[1].mtime = 200;
+	games[2].name = "no mtime";
+	games[2].type = GameScanner::ProjectType::RPG2k;
+
+	std::stringstream ss;
+	REQUIRE(GameScanner::WriteCache(ss, "/games", games));
+
+	auto cached = GameScanner::ReadCache(ss, "/games");
+	REQUIRE(cached.size() == 2);
+	CHECK(cached[0].name == "game");
+	CHECK(cached[0].type == GameScanner::ProjectType::EasyRpg);
+	CHECK(cached[0].mtime == 100);
+	CHECK(cached[1].name == "not a game");
+	CHECK(!cached[1].IsValid());
+	CHECK(cached[1].mtime == 200);
+
+	ss.clear();
+	ss.seekg(0);
+	CHECK(GameScanner::ReadCache(ss, "/other").empty());
+}
+
+TEST_SUITE_END();
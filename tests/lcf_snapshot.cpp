@@ -0,0 +1,96 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "lcf_snapshot.h"
+#include "filefinder.h"
+#include "main_data.h"
+#include "doctest.h"
+#include <lcf/ldb/reader.h>
+#include <lcf/rpg/database.h>
+
+static bool skip_tests() {
+#ifdef EMSCRIPTEN
+	return true;
+#else
+	return false;
+#endif
+}
+
+TEST_SUITE_BEGIN("LcfSnapshot" * doctest::skip(skip_tests()));
+
+TEST_CASE("SnapshotPath") {
+	std::string project_path = Main_Data::GetProjectPath();
+	LcfSnapshot::SetCacheDirectory(".");
+
+	Main_Data::SetProjectPath(EP_TEST_PATH "/game");
+	auto path = LcfSnapshot::GetSnapshotPath("RPG_RT.ldb");
+	CHECK(path == LcfSnapshot::GetSnapshotPath("RPG_RT.ldb"));
+	CHECK(path != LcfSnapshot::GetSnapshotPath("RPG_RT.lmt"));
+
+	// Games sharing the cache directory use different snapshots
+	Main_Data::SetProjectPath(EP_TEST_PATH "/notagame");
+	CHECK(path != LcfSnapshot::GetSnapshotPath("RPG_RT.ldb"));
+
+	LcfSnapshot::SetCacheDirectory("");
+	Main_Data::SetProjectPath(project_path);
+}
+
+TEST_CASE("RoundTrip") {
+	std::string project_path = Main_Data::GetProjectPath();
+	Main_Data::SetProjectPath(EP_TEST_PATH "/game");
+	LcfSnapshot::SetCacheDirectory(".");
+
+	lcf::rpg::Database source;
+	source.actors.resize(2);
+	source.actors[0].ID = 1;
+	source.actors[0].name = lcf::DBString("Alex");
+	source.actors[1].ID = 2;
+	source.actors[1].name = lcf::DBString("Brian");
+	std::stringstream is;
+	REQUIRE(lcf::LDB_Reader::Save(is, source, "1252"));
+
+	// Parses the source and writes the snapshot
+	auto db = LcfSnapshot::LoadDatabase("RPG_RT.ldb", is, "1252");
+	REQUIRE(db);
+	REQUIRE(db->actors.size() == 2);
+	CHECK(StringView(db->actors[0].name) == "Alex");
+
+	auto snapshot_path = LcfSnapshot::GetSnapshotPath("RPG_RT.ldb");
+	REQUIRE(FileFinder::Exists(snapshot_path));
+
+	// Rename an actor in the snapshot, the next load only returns it when the snapshot is read
+	std::string key;
+	{
+		std::ifstream snapshot_is(snapshot_path, std::ios_base::binary);
+		REQUIRE(std::getline(snapshot_is, key));
+	}
+	auto changed = *db;
+	changed.actors[0].name = lcf::DBString("Snapshot");
+	{
+		std::ofstream snapshot_os(snapshot_path, std::ios_base::binary | std::ios_base::trunc);
+		snapshot_os << key << "\n";
+		REQUIRE(lcf::LDB_Reader::Save(snapshot_os, changed, ""));
+	}
+
+	is.clear();
+	is.seekg(0);
+	auto cached = LcfSnapshot::LoadDatabase("RPG_RT.ldb", is, "1252");
+	REQUIRE(cached);
+	CHECK(StringView(cached->actors[0].name) == "Snapshot");
+	CHECK(cached->actors.size() == db->actors.size());
+	CHECK(cached->skills == db->skills);
+	CHECK(cached->system == db->system);
+
+	// A changed encoding replaces the snapshot
+	is.clear();
+	is.seekg(0);
+	auto reparsed = LcfSnapshot::LoadDatabase("RPG_RT.ldb", is, "932");
+	REQUIRE(reparsed);
+	CHECK(StringView(reparsed->actors[0].name) != "Snapshot");
+
+	std::remove(snapshot_path.c_str());
+	LcfSnapshot::SetCacheDirectory("");
+	Main_Data::SetProjectPath(project_path);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,58 @@
+#include "lru_cache.h"
+#include "doctest.h"
+#include <string>
+
+TEST_SUITE_BEGIN("LruCache");
+
+TEST_CASE("FindInsert") {
+	LruCache<int, std::string> cache;
+	CHECK(cache.Size() == 0);
+	CHECK(cache.Find(1) == nullptr);
+
+	cache.Insert(1, "one");
+	cache.Insert(2, "two");
+	REQUIRE(cache.Find(1));
+	CHECK(*cache.Find(1) == "one");
+	CHECK(cache.Size() == 2);
+
+	// Replaces the value
+	cache.Insert(1, "uno");
+	CHECK(*cache.Find(1) == "uno");
+	CHECK(cache.Size() == 2);
+
+	cache.Clear();
+	CHECK(cache.Size() == 0);
+	CHECK(cache.Find(2) == nullptr);
+}
+
+TEST_CASE("RemoveOldest") {
+	LruCache<int, int> cache;
+	cache.Insert(1, 10);
+	cache.Insert(2, 20);
+	cache.Insert(3, 30);
+	CHECK(cache.Oldest() == 10);
+
+	// Marks 1 as most recently used
+	CHECK(cache.Find(1));
+	CHECK(cache.Oldest() == 20);
+
+	cache.RemoveOldest();
+	CHECK(cache.Find(2) == nullptr);
+	CHECK(cache.Oldest() == 30);
+	CHECK(cache.Size() == 2);
+}
+
+TEST_CASE("TupleKey") {
+	using Key = std::tuple<const void*, int, std::string>;
+	LruCache<Key, int, TupleHash> cache;
+
+	cache.Insert(Key { nullptr, 1, "a" }, 1);
+	cache.Insert(Key { nullptr, 1, "b" }, 2);
+	cache.Insert(Key { nullptr, 2, "a" }, 3);
+	CHECK(cache.Size() == 3);
+	REQUIRE(cache.Find(Key { nullptr, 1, "b" }));
+	CHECK(*cache.Find(Key { nullptr, 1, "b" }) == 2);
+	CHECK(cache.Find(Key { nullptr, 3, "a" }) == nullptr);
+}
+
+TEST_SUITE_END();
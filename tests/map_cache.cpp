@@ -0,0 +1,113 @@
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include "map_cache.h"
+#include "system.h"
+#include "doctest.h"
+#include <lcf/lmu/reader.h>
+#include <lcf/rpg/map.h>
+
+namespace {
+	std::shared_ptr<lcf::rpg::Map> MakeMap(size_t tiles) {
+		auto map = std::make_shared<lcf::rpg::Map>();
+		map->width = 20;
+		map->height = 15;
+		map->lower_layer.resize(tiles);
+		map->upper_layer.resize(tiles);
+		return map;
+	}
+
+	Filesystem_Stream::InputStream MakeMapStream(const lcf::rpg::Map& map) {
+		std::stringstream ss;
+		REQUIRE(lcf::LMU_Reader::Save(ss, map, lcf::EngineVersion::e2k, "1252"));
+		return Filesystem_Stream::InputStream(new std::stringbuf(ss.str()));
+	}
+}
+
+TEST_SUITE_BEGIN("MapCache");
+
+TEST_CASE("Get") {
+	MapCache::Add(1, MakeMap(300));
+
+	auto map = MapCache::Get(1);
+	REQUIRE(map);
+	CHECK(map->width == 20);
+	CHECK(MapCache::Contains(1));
+	CHECK(!MapCache::Get(2));
+	CHECK(!MapCache::Contains(2));
+
+	MapCache::Clear();
+	CHECK(!MapCache::Get(1));
+}
+
+TEST_CASE("Budget") {
+	// Each map is estimated at about 12 MiB, the budget is 32 MiB
+	constexpr size_t tiles = 3 * 1024 * 1024;
+
+	MapCache::Add(1, MakeMap(tiles));
+	MapCache::Add(2, MakeMap(tiles));
+	// Map 2 becomes the least recently used one
+	CHECK(MapCache::Get(1));
+	MapCache::Add(3, MakeMap(tiles));
+
+	CHECK(MapCache::Contains(1));
+	CHECK(!MapCache::Contains(2));
+	CHECK(MapCache::Contains(3));
+
+	// A single map exceeding the budget is kept
+	MapCache::Add(4, MakeMap(tiles * 3));
+	CHECK(MapCache::Contains(4));
+	CHECK(!MapCache::Contains(1));
+	CHECK(!MapCache::Contains(3));
+
+	MapCache::Clear();
+}
+
+TEST_CASE("Preload") {
+	auto map = MakeMap(300);
+	map->chipset_id = 7;
+
+	for (int map_id = 1; map_id <= 8; ++map_id) {
+		MapCache::Preload(map_id, "Map.lmu", MakeMapStream(*map), "1252", false);
+#ifdef SUPPORT_THREADS
+		CHECK(MapCache::Contains(map_id));
+#endif
+	}
+
+	// Depending on the worker progress the map was parsed (and is returned) or
+	// the queued job was dropped (and the map must be loaded by the caller).
+	for (int map_id = 8; map_id >= 1; --map_id) {
+		auto cached = MapCache::Get(map_id);
+		CHECK(MapCache::Contains(map_id) == (cached != nullptr));
+		if (cached) {
+			CHECK(cached->chipset_id == 7);
+			CHECK(cached->lower_layer.size() == 300);
+		}
+	}
+
+	MapCache::Clear();
+	CHECK(!MapCache::Contains(1));
+}
+
+#ifdef SUPPORT_THREADS
+TEST_CASE("PreloadLeastRecentlyUsed") {
+	constexpr size_t tiles = 3 * 1024 * 1024;
+
+	MapCache::Add(1, MakeMap(tiles));
+	MapCache::Add(2, MakeMap(tiles));
+
+	// The preloaded map does not fit into the budget and is evicted instead of the visited maps
+	MapCache::Preload(3, "Map.lmu", MakeMapStream(*MakeMap(tiles)), "1252", false);
+	for (int i = 0; i < 500 && MapCache::Contains(3); ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	CHECK(!MapCache::Contains(3));
+	CHECK(MapCache::Contains(1));
+	CHECK(MapCache::Contains(2));
+
+	MapCache::Clear();
+}
+#endif
+
+TEST_SUITE_END();
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "filefinder.h"
+#include "mapped_file.h"
+#include "utils.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("MappedFile");
+
+TEST_CASE("Contents") {
+	auto mf = MappedFile::Open(EP_TEST_PATH "/game/RPG_RT.ldb");
+	if (!mf) {
+		// Memory mapping not supported on this platform
+		return;
+	}
+
+	std::ifstream is(EP_TEST_PATH "/game/RPG_RT.ldb", std::ios::binary);
+	std::vector<uint8_t> expected((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+	REQUIRE_EQ(mf->size(), expected.size());
+	CHECK(std::equal(expected.begin(), expected.end(), mf->data()));
+}
+
+TEST_CASE("Invalid") {
+	CHECK(!MappedFile::Open(EP_TEST_PATH "/notafile"));
+	CHECK(!MappedFile::Open(EP_TEST_PATH "/game"));
+}
+
+TEST_CASE("InputStream") {
+	auto is = FileFinder::OpenMappedInputStream(EP_TEST_PATH "/platform/1kb");
+	REQUIRE(is);
+
+	auto data = is.GetMemoryData();
+	if (data.empty()) {
+		// Memory mapping not supported on this platform
+		return;
+	}
+	CHECK(data.size() == 1024);
+
+	char c;
+	is.seekg(1000);
+	CHECK(is.tellg() == 1000);
+	CHECK(is.get(c));
+	CHECK(c == static_cast<char>(data[1000]));
+
+	is.seekg(0);
+	auto buffer = Utils::ReadStream(is);
+	REQUIRE(buffer.size() == data.size());
+	CHECK(std::equal(buffer.begin(), buffer.end(), data.begin()));
+
+	// Mapping is opt-in, regular streams can be long-lived or read files the Player writes
+	auto file_is = FileFinder::OpenInputStream(EP_TEST_PATH "/platform/1kb");
+	REQUIRE(file_is);
+	CHECK(file_is.GetMemoryData().empty());
+}
+
+TEST_SUITE_END();
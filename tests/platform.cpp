@@ -50,6 +50,11 @@ TEST_CASE("GetSize") {
 	CHECK(Platform::File(bad).GetSize() == -1);
 }
 
+TEST_CASE("Sync") {
+	CHECK(Platform::File(onekb).Sync());
+	CHECK(!Platform::File(bad).Sync());
+}
+
 TEST_CASE("ReadDirectory") {
 	Platform::Directory dir(EP_TEST_PATH "/platform");
 
@@ -96,6 +96,11 @@ TEST_CASE("RTP 2003: Lookup Any to RTP with 1 hit") {
 	REQUIRE(types[0] == RTP::Type::RPG2003_OfficialEnglish);
 }
 
+TEST_CASE("RTP 2000: Lookup Any to RTP with wrong category") {
+	REQUIRE(RTP::LookupAnyToRtp("chipset", "actor1", 2000).empty());
+	REQUIRE(RTP::LookupAnyToRtp("invalid", "actor1", 2000).empty());
+}
+
 TEST_CASE("RTP 2000: Lookup RTP to RTP (Found)") {
 	bool is_rtp_asset;
 
@@ -0,0 +1,46 @@
+#include "save_title_reader.h"
+#include "doctest.h"
+#include <lcf/lsd/reader.h>
+#include <sstream>
+
+static std::string MakeSave() {
+	lcf::rpg::Save save;
+	save.title.timestamp = 44000.5;
+	save.title.hero_name = "Alex";
+	save.title.hero_level = 12;
+	save.title.hero_hp = 345;
+	save.title.face1_name = "Actor1";
+	save.title.face1_id = 3;
+	// Chunks after the title are not needed
+	save.inventory.gold = 999;
+	save.system.switches.resize(5000, true);
+
+	std::stringstream ss;
+	REQUIRE(lcf::LSD_Reader::Save(ss, save, lcf::EngineVersion::e2k3, "UTF-8"));
+	return ss.str();
+}
+
+TEST_SUITE_BEGIN("SaveTitleReader");
+
+TEST_CASE("Load") {
+	std::istringstream is(MakeSave());
+	auto title = SaveTitleReader::Load(is, "UTF-8");
+	REQUIRE(title);
+	CHECK(title->timestamp == 44000.5);
+	CHECK(title->hero_name == "Alex");
+	CHECK(title->hero_level == 12);
+	CHECK(title->hero_hp == 345);
+	CHECK(title->face1_name == "Actor1");
+	CHECK(title->face1_id == 3);
+}
+
+TEST_CASE("Invalid") {
+	std::istringstream empty;
+	CHECK(!SaveTitleReader::Load(empty, "UTF-8"));
+
+	auto data = MakeSave();
+	std::istringstream truncated(data.substr(0, 20));
+	CHECK(!SaveTitleReader::Load(truncated, "UTF-8"));
+}
+
+TEST_SUITE_END();
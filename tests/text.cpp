@@ -3,6 +3,7 @@
 #include "cache.h"
 #include "bitmap.h"
 #include "font.h"
+#include <algorithm>
 #include <iostream>
 #include "doctest.h"
 
@@ -48,4 +49,42 @@ TEST_CASE("TextDrawColorStrReturn") {
 	REQUIRE_EQ(draw(10, 0, "xy\nz"), Rect(10, 0, cwh * 2, ch *2));
 }
 
+TEST_CASE("TextDrawSystemStrCached") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto font = Font::Default();
+	auto system = Cache::SysBlack();
+
+	// Reference: Glyph by glyph
+	auto expected = Bitmap::Create(width, height);
+	int x = 5;
+	for (char32_t c: U"Hello") {
+		if (c != 0) {
+			x += Text::Draw(*expected, x, 7, *font, *system, 0, c, false).width;
+		}
+	}
+
+	auto check = [&]() {
+		auto surface = Bitmap::Create(width, height);
+		REQUIRE_EQ(Text::Draw(*surface, 5, 7, *font, *system, 0, "Hello"), Rect(5, 7, cwh * 5, ch));
+		auto* a = reinterpret_cast<const uint32_t*>(surface->pixels());
+		auto* b = reinterpret_cast<const uint32_t*>(expected->pixels());
+		REQUIRE(std::equal(a, a + width * height, b));
+	};
+
+	Text::ClearCache();
+	check();
+	// Drawn from the cache
+	check();
+}
+
+TEST_CASE("TextGetSizeCached") {
+	auto font = Font::Default();
+
+	Text::ClearCache();
+	REQUIRE_EQ(Text::GetSize(*font, "Hello"), font->GetSize("Hello"));
+	// Measured from the cache
+	REQUIRE_EQ(Text::GetSize(*font, "Hello"), Rect(0, 0, cwh * 5, ch));
+	REQUIRE_EQ(Text::GetSize(*font, ""), Rect(0, 0, 0, ch));
+}
+
 TEST_SUITE_END();
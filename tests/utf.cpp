@@ -22,6 +22,9 @@ struct TestSet {
 TestSet tests[] = {
 	//Valid Strings
 	TS("κόσμε"),
+	//Long ASCII runs mixed with multibyte chars
+	TS("Alex landed a critical hit on \U000003BA\U000003CC\U000003C3\U000003BC\U000003B5!"),
+	TS("0123456789abcdef\U0001F600ghijklmnopqrstuvwxyz\U0000FFFD"),
 	//First Char tests
 	TS("\U00000000"),
 	TS("\U00000080"),
@@ -97,4 +97,16 @@ TEST_CASE("limits") {
 
 }
 
+TEST_CASE("cached") {
+	std::string line = "Alex takes 300 damage! Skeleton Attacks! Skeleton is defeated!";
+	auto lines = WordWrap(line);
+	REQUIRE_EQ(lines.size(), 2);
+
+	// Wrapped from the cache
+	REQUIRE_EQ(WordWrap(line), lines);
+
+	// Different limit is not taken from the cache
+	REQUIRE_EQ(WordWrap(line, 0).size(), 9);
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,53 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Packs a game directory into an archive which can be passed to the
+// Player instead of the directory.
+
+#include <cstdio>
+#include "filefinder.h"
+#include "filesystem_archive.h"
+
+int main(int argc, char* argv[]) {
+	if (argc != 3) {
+		std::fprintf(stderr, "Usage: %s GAME_DIRECTORY ARCHIVE\n", argv[0]);
+		return 1;
+	}
+
+	{
+		auto os = FileFinder::OpenOutputStream(argv[2], std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		if (!os) {
+			std::fprintf(stderr, "Cannot open %s for writing\n", argv[2]);
+			return 1;
+		}
+
+		if (!ArchiveFilesystem::Pack(argv[1], os) || !os.flush()) {
+			std::fprintf(stderr, "Packing %s failed\n", argv[1]);
+			return 1;
+		}
+		// The archive is closed here, the check below reads the complete file
+	}
+
+	auto archive = ArchiveFilesystem::Open(argv[2]);
+	if (!archive) {
+		std::fprintf(stderr, "%s is not a valid archive after packing\n", argv[2]);
+		return 1;
+	}
+	std::printf("Packed %zu files\n", archive->GetEntries().size());
+
+	return 0;
+}